@@ -1,38 +1,399 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <pthread.h>
 
 /*******************************************************
  *  Définitions des constantes
  *******************************************************/
 #define TAILLE_PLATEAU 19
+#define PRISES_VICTOIRE 10   // prises qui donnent la victoire
 /*
- * Structure : Pion
- * ----------------
- *  - Rôle : représenter un pion sur le plateau.
+ * Disposition des bitboards
+ * -------------------------
+ *  - la case (ligne, colonne) est le bit ligne * LARGEUR_LIGNE + colonne
+ *  - chaque ligne compte une colonne de garde (colonne 19) toujours vide :
+ *    un décalage de 1 (horizontal), 19 (diagonale "/") ou 21 (diagonale "\")
+ *    qui sort du plateau par un bord gauche ou droit tombe sur une garde,
+ *    un décalage de 20 (vertical) qui sort par le haut ou le bas sort du
+ *    tableau ; aucun motif ne peut donc se replier d'une ligne sur l'autre
+ *  - 19 lignes de 20 bits = 380 bits, rangés dans 6 mots de 64 bits
+ */
+#define LARGEUR_LIGNE (TAILLE_PLATEAU + 1)
+#define NB_CASES_BITS (TAILLE_PLATEAU * LARGEUR_LIGNE)
+#define NB_MOTS       ((NB_CASES_BITS + 63) / 64)
+
+/*
+ * Structure : Bitboard
+ * --------------------
+ *  - Rôle : ensemble de cases du plateau, un bit par case
  *  - Attribut :
- *      symbole : 'X', 'O' ou '.' (pour une case vide)
- *
+ *      mots : NB_MOTS mots de 64 bits (bit i du plateau = bit i % 64 du mot i / 64)
  */
 typedef struct {
-    char symbole; // 'X', 'O', ou '.' pour une case vide
-} Pion;
+    uint64_t mots[NB_MOTS];
+} Bitboard;
+
+/*
+ * Évaluation incrémentale par lignes
+ * ----------------------------------
+ *  - le plateau compte NB_LIGNES lignes : 19 rangées, 19 colonnes,
+ *    37 diagonales "\" et 37 diagonales "/" ; LIGNE_DE[d][i] et
+ *    RANG_DANS[d][i] donnent la ligne de direction d qui passe par le
+ *    bit i et la position de la case dans cette ligne
+ *  - Plateau.lignes[j][l] est le code de la ligne l pour le joueur j :
+ *    bit k à 1 si la k-ième case de la ligne lui appartient
+ *  - la valeur d'une ligne est la somme, sur ses fenêtres de 5 cases,
+ *    de MOTIFS_5 (pions d'un seul joueur : 1, 10, 100, 1000 ou 100000
+ *    selon leur nombre) et, sur ses fenêtres de 4 cases, de MOTIFS_4
+ *    (menace de prise X O O . ou . O O X) ; les tables sont indexées
+ *    par (code X, code O) de la fenêtre et comptées du point de vue de X
+ *  - Plateau.evaluation est la somme des valeurs de toutes les lignes :
+ *    poser ou retirer un pion ne change que les fenêtres qui le
+ *    contiennent, sur les 4 lignes qui passent par sa case
+ */
+#define NB_LIGNES  (2 * TAILLE_PLATEAU + 2 * (2 * TAILLE_PLATEAU - 1))
+#define VALEUR_PRISE_MENACEE 60
+
+static int16_t LIGNE_DE[4][NB_CASES_BITS];
+static int8_t  RANG_DANS[4][NB_CASES_BITS];
+static int8_t  LONGUEUR_LIGNE[NB_LIGNES];
+static int32_t MOTIFS_5[1 << 10];
+static int32_t MOTIFS_4[1 << 8];
 
 /*
  * Structure : Plateau
  * -------------------
  *  - Rôle : représenter l'état complet d'un plateau de Penté
  *  - Attributs :
- *      plateau      : tableau 19×19 de Pion
+ *      pions_X, pions_O : cases occupées par chaque joueur (bitboards)
  *      prises_joueur_X : nombre de pions capturés par le joueur X
  *      prises_joueur_O : nombre de pions capturés par le joueur O
+ *      cle             : clé de Zobrist de la position (pions, prises
+ *                        et joueur au trait), tenue à jour par
+ *                        placer_pion et verifier_prise
+ *      lignes          : codes des lignes de chaque joueur (voir
+ *                        l'évaluation incrémentale)
+ *      evaluation      : valeur des motifs de toutes les lignes, du
+ *                        point de vue de X, tenue à jour comme cle
  */
 typedef struct {
-    Pion plateau[TAILLE_PLATEAU][TAILLE_PLATEAU];
+    Bitboard pions_X;
+    Bitboard pions_O;
     int prises_joueur_X;
     int prises_joueur_O;
+    uint64_t cle;
+    uint32_t lignes[2][NB_LIGNES];
+    int32_t evaluation;
 } Plateau;
 
+/* Pas des 4 directions sur le plateau à gardes : horizontal, vertical, "\", "/" */
+static const int PAS_DIRECTIONS[4] = { 1, LARGEUR_LIGNE, LARGEUR_LIGNE + 1, LARGEUR_LIGNE - 1 };
+
+/* Pas des 8 sens (d < 4 : PAS_DIRECTIONS[d], sinon son opposé) */
+static inline int pas_sens(int d) {
+    return (d < 4) ? PAS_DIRECTIONS[d] : -PAS_DIRECTIONS[d - 4];
+}
+
+
+/*
+ * Clés de Zobrist
+ * ---------------
+ *  - ZOBRIST_PIONS[j][i] : pion du joueur j (0 : X, 1 : O) sur le bit i
+ *  - ZOBRIST_PRISES[j][k] : le joueur j a k prises (k borné à
+ *    ZOBRIST_PRISES_MAX - 1, au-delà la partie est finie)
+ *  - ZOBRIST_TRAIT : X au trait (O commence, le plateau vide a O au trait)
+ *  La clé d'une position est le XOR des clés de ses éléments ; un
+ *  changement ne coûte qu'un ou deux XOR.
+ */
+#define ZOBRIST_PRISES_MAX 32
+
+static uint64_t ZOBRIST_PIONS[2][NB_CASES_BITS];
+static uint64_t ZOBRIST_PRISES[2][ZOBRIST_PRISES_MAX];
+static uint64_t ZOBRIST_TRAIT;
+
+/*
+ * -------------------------------------------------------
+ * action : initialiser_zobrist
+ * -------------------------------------------------------
+ * But          : Remplir les tables de Zobrist (suite
+ *                splitmix64 de graine fixe : les clés sont
+ *                les mêmes d'une exécution à l'autre) ; sans
+ *                effet après le premier appel
+ * -------------------------------------------------------
+ */
+static void initialiser_zobrist(void) {
+    static bool pret = false;
+    if (pret) return;
+    uint64_t graine = 0x9E3779B97F4A7C15u;
+    uint64_t *tables[3] = { &ZOBRIST_PIONS[0][0], &ZOBRIST_PRISES[0][0], &ZOBRIST_TRAIT };
+    int tailles[3] = { 2 * NB_CASES_BITS, 2 * ZOBRIST_PRISES_MAX, 1 };
+    for (int t = 0; t < 3; t++) {
+        for (int i = 0; i < tailles[t]; i++) {
+            uint64_t z = (graine += 0x9E3779B97F4A7C15u);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+            tables[t][i] = z ^ (z >> 31);
+        }
+    }
+    pret = true;
+}
+
+static inline uint64_t zobrist_prises(int joueur, int prises) {
+    return ZOBRIST_PRISES[joueur][prises < ZOBRIST_PRISES_MAX ? prises : ZOBRIST_PRISES_MAX - 1];
+}
+
+/*
+ * -------------------------------------------------------
+ * Fonction: bit_case / tester_bit / poser_bit / effacer_bit
+ * -------------------------------------------------------
+ * But          : Accès bit à bit à un bitboard : indice du
+ *                bit de la case (ligne, colonne), lecture,
+ *                mise à 1 et mise à 0 du bit i
+ * -------------------------------------------------------
+ */
+static inline int bit_case(int ligne, int colonne) {
+    return ligne * LARGEUR_LIGNE + colonne;
+}
+
+static inline bool tester_bit(const Bitboard *b, int i) {
+    return (b->mots[i >> 6] >> (i & 63)) & 1;
+}
+
+static inline void poser_bit(Bitboard *b, int i) {
+    b->mots[i >> 6] |= (uint64_t)1 << (i & 63);
+}
+
+static inline void effacer_bit(Bitboard *b, int i) {
+    b->mots[i >> 6] &= ~((uint64_t)1 << (i & 63));
+}
+
+
+/*
+ * -------------------------------------------------------
+ * Fonction: decaler
+ * -------------------------------------------------------
+ * Nature       : Fonction
+ * But          : Décaler tout un bitboard de n cases :
+ *                le bit i du résultat est le bit i + n de b
+ *                (n > 0 : vers les indices faibles, n < 0 :
+ *                vers les indices forts), 0 hors du tableau
+ * Données      : b (pointeur constant vers Bitboard),
+ *                n : entier (|n| < 64 * NB_MOTS)
+ * Résultat     : le bitboard décalé
+ * -------------------------------------------------------
+ */
+static Bitboard decaler(const Bitboard *b, int n) {
+    Bitboard r;
+    int q = (n >= 0 ? n : -n) / 64;
+    int s = (n >= 0 ? n : -n) % 64;
+    for (int i = 0; i < NB_MOTS; i++) {
+        uint64_t bas, haut;
+        if (n >= 0) {
+            bas  = (i + q < NB_MOTS) ? b->mots[i + q] : 0;
+            haut = (i + q + 1 < NB_MOTS) ? b->mots[i + q + 1] : 0;
+            r.mots[i] = s ? (bas >> s) | (haut << (64 - s)) : bas;
+        } else {
+            haut = (i - q >= 0) ? b->mots[i - q] : 0;
+            bas  = (i - q - 1 >= 0) ? b->mots[i - q - 1] : 0;
+            r.mots[i] = s ? (haut << s) | (bas >> (64 - s)) : haut;
+        }
+    }
+    return r;
+}
+
+/*
+ * -------------------------------------------------------
+ * action : et_bitboard
+ * -------------------------------------------------------
+ * But          : a <- a ET b, mot à mot
+ * -------------------------------------------------------
+ */
+static inline void et_bitboard(Bitboard *a, const Bitboard *b) {
+    for (int i = 0; i < NB_MOTS; i++) {
+        a->mots[i] &= b->mots[i];
+    }
+}
+
+/*
+ * -------------------------------------------------------
+ * Fonction: pions_joueur
+ * -------------------------------------------------------
+ * But          : Bitboard des pions du joueur 'symbole'
+ *                ('X' ou 'O')
+ * -------------------------------------------------------
+ */
+static inline Bitboard *pions_joueur(Plateau *p, char symbole) {
+    return (symbole == 'X') ? &p->pions_X : &p->pions_O;
+}
+
+static inline const Bitboard *pions_joueur_const(const Plateau *p, char symbole) {
+    return (symbole == 'X') ? &p->pions_X : &p->pions_O;
+}
+
+/*
+ * -------------------------------------------------------
+ * action : initialiser_motifs
+ * -------------------------------------------------------
+ * But          : Remplir les tables des lignes (LIGNE_DE,
+ *                RANG_DANS, LONGUEUR_LIGNE) et les tables de
+ *                valeur des motifs ; sans effet après le
+ *                premier appel
+ * -------------------------------------------------------
+ */
+static void initialiser_motifs(void) {
+    static bool pret = false;
+    if (pret) return;
+    static const int32_t valeur_pions[6] = { 0, 1, 10, 100, 1000, 100000 };
+    int n = TAILLE_PLATEAU;
+
+    for (int r = 0; r < n; r++) {
+        for (int c = 0; c < n; c++) {
+            int i = bit_case(r, c);
+            int ligne[4] = { r, n + c, 2 * n + (c - r + n - 1), 2 * n + (2 * n - 1) + (r + c) };
+            int rang[4]  = { c, r, (r < c) ? r : c, (r + c < n) ? r : r - (r + c - (n - 1)) };
+            for (int d = 0; d < 4; d++) {
+                LIGNE_DE[d][i] = (int16_t)ligne[d];
+                RANG_DANS[d][i] = (int8_t)rang[d];
+                LONGUEUR_LIGNE[ligne[d]]++;
+            }
+        }
+    }
+
+    for (int x = 0; x < 32; x++) {
+        for (int o = 0; o < 32; o++) {
+            int32_t v = 0;
+            if (x && !o) v = valeur_pions[__builtin_popcount(x)];
+            if (o && !x) v = -valeur_pions[__builtin_popcount(o)];
+            MOTIFS_5[x | o << 5] = v;
+        }
+    }
+    // fenêtre de 4 : bit 0 = première case ; paire adverse au milieu,
+    // un pion du joueur à un bout et une case vide à l'autre
+    for (int x = 0; x < 16; x++) {
+        for (int o = 0; o < 16; o++) {
+            int32_t v = 0;
+            if ((x & o) == 0) {
+                if (o == 0x6 && (x == 0x1 || x == 0x8)) v = VALEUR_PRISE_MENACEE;
+                if (x == 0x6 && (o == 0x1 || o == 0x8)) v = -VALEUR_PRISE_MENACEE;
+            }
+            MOTIFS_4[x | o << 4] = v;
+        }
+    }
+    pret = true;
+}
+
+/*
+ * -------------------------------------------------------
+ * Fonction: valeur_autour
+ * -------------------------------------------------------
+ * But          : Somme des valeurs des fenêtres de la ligne
+ *                (codes x et o, longueur lg) qui contiennent
+ *                la position k
+ * -------------------------------------------------------
+ */
+static inline int32_t valeur_autour(uint32_t x, uint32_t o, int lg, int k) {
+    int32_t v = 0;
+    int debut = (k >= 4) ? k - 4 : 0;
+    for (int f = debut; f <= k && f + 5 <= lg; f++) {
+        v += MOTIFS_5[((x >> f) & 31) | ((o >> f) & 31) << 5];
+    }
+    debut = (k >= 3) ? k - 3 : 0;
+    for (int f = debut; f <= k && f + 4 <= lg; f++) {
+        v += MOTIFS_4[((x >> f) & 15) | ((o >> f) & 15) << 4];
+    }
+    return v;
+}
+
+/*
+ * -------------------------------------------------------
+ * action : basculer_case
+ * -------------------------------------------------------
+ * But          : Pose (ou retire) le pion du joueur j (0 : X,
+ *                1 : O) sur le bit i : bitboard, codes des 4
+ *                lignes de la case et évaluation, mise à jour
+ *                sur les seules fenêtres qui contiennent la case
+ * -------------------------------------------------------
+ */
+static void basculer_case(Plateau *p, int i, int j) {
+    Bitboard *b = (j == 0) ? &p->pions_X : &p->pions_O;
+    b->mots[i >> 6] ^= (uint64_t)1 << (i & 63);
+    for (int d = 0; d < 4; d++) {
+        int l = LIGNE_DE[d][i], k = RANG_DANS[d][i], lg = LONGUEUR_LIGNE[l];
+        uint32_t *x = &p->lignes[0][l], *o = &p->lignes[1][l];
+        p->evaluation -= valeur_autour(*x, *o, lg, k);
+        p->lignes[j][l] ^= (uint32_t)1 << k;
+        p->evaluation += valeur_autour(*x, *o, lg, k);
+    }
+}
+
+/*
+ * -------------------------------------------------------
+ * Fonction: symbole_case
+ * -------------------------------------------------------
+ * But          : Symbole de la case (ligne, colonne) :
+ *                'X', 'O' ou '.' pour une case vide
+ * -------------------------------------------------------
+ */
+static char symbole_case(const Plateau *p, int ligne, int colonne) {
+    int i = bit_case(ligne, colonne);
+    if (tester_bit(&p->pions_X, i)) return 'X';
+    if (tester_bit(&p->pions_O, i)) return 'O';
+    return '.';
+}
+
+/*
+ * -------------------------------------------------------
+ * Fonction: alignements
+ * -------------------------------------------------------
+ * Nature       : Fonction
+ * But          : Débuts des alignements de 5 pions dans
+ *                la direction de pas 'pas' : le bit i est à 1
+ *                si les cases i, i+pas, ..., i+4.pas sont
+ *                toutes dans b (trois décalages et trois ET)
+ * Données      : b (pointeur constant vers Bitboard), pas
+ * Résultat     : bitboard des débuts d'alignement
+ * -------------------------------------------------------
+ */
+static Bitboard alignements(const Bitboard *b, int pas) {
+    Bitboard deux = decaler(b, pas);
+    et_bitboard(&deux, b);                      // i, i+pas
+    Bitboard quatre = decaler(&deux, 2 * pas);
+    et_bitboard(&quatre, &deux);                // i .. i+3.pas
+    Bitboard cinq = decaler(b, 4 * pas);
+    et_bitboard(&cinq, &quatre);                // i .. i+4.pas
+    return cinq;
+}
+
+/*
+ * -------------------------------------------------------
+ * Fonction: prises
+ * -------------------------------------------------------
+ * Nature       : Fonction
+ * But          : Cases d'où un pion du joueur capture dans
+ *                la direction de pas 'pas' (motif X O O X) :
+ *                le bit i est à 1 si i+pas et i+2.pas sont
+ *                à l'adversaire et i+3.pas au joueur
+ * Données      : joueur, adversaire (pointeurs constants
+ *                vers Bitboard), pas (positif ou négatif)
+ * Résultat     : bitboard des cases de prise
+ * -------------------------------------------------------
+ */
+static Bitboard prises(const Bitboard *joueur, const Bitboard *adversaire, int pas) {
+    Bitboard r = decaler(adversaire, pas);
+    Bitboard b = decaler(adversaire, 2 * pas);
+    et_bitboard(&r, &b);
+    b = decaler(joueur, 3 * pas);
+    et_bitboard(&r, &b);
+    return r;
+}
+
 
 /*
  * -------------------------------------------------------
@@ -56,20 +417,26 @@ bool position_valide(int ligne, int colonne) {
  * -------------------------------------------------------
  * action : initialiser_plateau
  * -------------------------------------------------------
- * But          : Mettre tout le plateau à '.' (cases vides)
- *                et réinitialiser les compteurs de prises.
+ * But          : Vider les deux bitboards et les codes des
+ *                lignes (cases vides), réinitialiser les
+ *                compteurs de prises et calculer la clé de
+ *                Zobrist du plateau vide.
  * Données      : p (pointeur vers Plateau)
- * Variables locales : i, j (pour parcourir le plateau)
+ * Variables locales : i (pour parcourir les mots)
  * -------------------------------------------------------
  */
 void initialiser_plateau(Plateau *p) {
-    for (int i = 0; i < TAILLE_PLATEAU; i++) {
-        for (int j = 0; j < TAILLE_PLATEAU; j++) {
-            p->plateau[i][j].symbole = '.';  // case vide
-        }
+    initialiser_zobrist();
+    initialiser_motifs();
+    for (int i = 0; i < NB_MOTS; i++) {
+        p->pions_X.mots[i] = 0;  // cases vides
+        p->pions_O.mots[i] = 0;
     }
     p->prises_joueur_X = 0;
     p->prises_joueur_O = 0;
+    p->cle = zobrist_prises(0, 0) ^ zobrist_prises(1, 0);  // O au trait
+    memset(p->lignes, 0, sizeof p->lignes);
+    p->evaluation = 0;                                     // lignes vides
 }
 /*
  * -------------------------------------------------------
@@ -81,19 +448,17 @@ void initialiser_plateau(Plateau *p) {
  * Données      : p (pointeur constant vers Plateau)
  * Résultat     : true si le plateau est plein,
  *                false sinon
- * Variables locales : i, j (pour parcourir le plateau)
+ * Variables locales : i (pour parcourir les mots),
+ *                     occupees (nombre de cases occupées)
  * -------------------------------------------------------
  */
 
 bool est_plein(const Plateau *p) {  //--- AJOUT pour match nul ---
-    for (int i = 0; i < TAILLE_PLATEAU; i++) {
-        for (int j = 0; j < TAILLE_PLATEAU; j++) {
-            if (p->plateau[i][j].symbole == '.') {
-                return false;
-            }
-        }
+    int occupees = 0;
+    for (int i = 0; i < NB_MOTS; i++) {
+        occupees += __builtin_popcountll(p->pions_X.mots[i] | p->pions_O.mots[i]);
     }
-    return true;
+    return occupees == TAILLE_PLATEAU * TAILLE_PLATEAU;
 }
 /*
  * -------------------------------------------------------
@@ -123,7 +488,7 @@ void afficher_plateau(const Plateau *p) {
         printf("%3d ", i + 1);
         // Cases de la ligne i
         for (int j = 0; j < TAILLE_PLATEAU; j++) {
-            printf(" %c ", p->plateau[i][j].symbole);
+            printf(" %c ", symbole_case(p, i, j));
         }
         printf("\n");
     }
@@ -154,11 +519,13 @@ void afficher_plateau(const Plateau *p) {
 bool placer_pion(Plateau *p, int ligne, int colonne, char symbole) {
     // Vérifie la validité et si la case est vide
     if (!position_valide(ligne, colonne) ||
-        p->plateau[ligne][colonne].symbole != '.') {
+        symbole_case(p, ligne, colonne) != '.') {
         return false;
     }
-    // Place le symbole
-    p->plateau[ligne][colonne].symbole = symbole;
+    // Place le symbole ; l'adversaire prend le trait
+    int i = bit_case(ligne, colonne);
+    basculer_case(p, i, symbole == 'X' ? 0 : 1);
+    p->cle ^= ZOBRIST_PIONS[symbole == 'X' ? 0 : 1][i] ^ ZOBRIST_TRAIT;
     return true;
 }
 
@@ -177,55 +544,26 @@ bool placer_pion(Plateau *p, int ligne, int colonne, char symbole) {
  * Résultat     : true si un alignement >= 5 est détecté,
  *                false sinon
  * Variables locales :
- *    directions[4][2] : tableau des 4 directions à tester
- *    compteur         : entier comptant le nombre de pions
- *    dx, dy, x, y     : entiers pour naviguer sur le plateau
+ *    pions  : bitboard des pions du joueur
+ *    i      : bit de la case posée
+ *    pas    : pas de la direction testée (PAS_DIRECTIONS)
+ *    debuts : débuts des alignements de 5 (alignements)
  * -------------------------------------------------------
  */
 bool verifier_alignement(const Plateau *p, int ligne, int colonne, char symbole) {
-    // 4 directions de base
-    int directions[4][2] = {
-        {0, 1},   // horizontal
-        {1, 0},   // vertical
-        {1, 1},   // diagonale "\"
-        {1, -1}   // diagonale "/"
-    };
-
-    // Pour chaque direction, on compte
-    // le pion actuel + pions identiques dans les 2 sens
-    for (int d = 0; d < 4; d++) {
-        // compteur = 1 (le pion posé)
-        int compteur = 1;
-
-        // sens positif
-        int dx = directions[d][0];
-        int dy = directions[d][1];
-        int x = ligne + dx;
-        int y = colonne + dy;
-
-        while (position_valide(x, y) &&
-               p->plateau[x][y].symbole == symbole) {
-            compteur++;
-            x += dx;
-            y += dy;
-        }
-
-        // sens négatif
-        dx = -dx;
-        dy = -dy;
-        x = ligne + dx;
-        y = colonne + dy;
-
-        while (position_valide(x, y) &&
-               p->plateau[x][y].symbole == symbole) {
-            compteur++;
-            x += dx;
-            y += dy;
-        }
+    const Bitboard *pions = pions_joueur_const(p, symbole);
+    int i = bit_case(ligne, colonne);
 
-        // Vérifier si on a 5 ou plus
-        if (compteur >= 5) {
-            return true;
+    // Pour chaque direction, un alignement passe par i
+    // s'il commence en i - k.pas avec 0 <= k <= 4
+    for (int d = 0; d < 4; d++) {
+        int pas = PAS_DIRECTIONS[d];
+        Bitboard debuts = alignements(pions, pas);
+        for (int k = 0; k <= 4; k++) {
+            int debut = i - k * pas;
+            if (debut >= 0 && tester_bit(&debuts, debut)) {
+                return true;
+            }
         }
     }
 
@@ -235,7 +573,7 @@ bool verifier_alignement(const Plateau *p, int ligne, int colonne, char symbole)
 
 /*
  * -------------------------------------------------------
- * action : verifier_prise
+ * Fonction: verifier_prise
  * -------------------------------------------------------
  * But          : Vérifier si, en posant un pion
  *                (ligne,colonne), on capture deux pions
@@ -247,156 +585,1661 @@ bool verifier_alignement(const Plateau *p, int ligne, int colonne, char symbole)
  * données ligne: entier,
  *                colonne:entier,
  *                symbole:chaine de caractère représentant le joueur ('O' ou 'X')
+ * Résultat     : sens des prises effectuées (bit d à 1 si
+ *                la paire du sens d, pas pas_sens(d), a été
+ *                prise), de quoi les défaire (annuler_coup)
  * Variables locales :
- *    adversaire       : chaine de caractere ('O' si symbole == 'X', sinon 'X')
- *    directions[8][2] : tableau des 8 directions à tester
- *    x1,y1,x2,y2,x3,y3 : entier (indices pour repérer les pions)
- * -------------------------------------------------------
- */
-void verifier_prise(Plateau *p, int ligne, int colonne, char symbole) {
-    char adversaire = (symbole == 'X') ? 'O' : 'X';
-
-    // 8 directions (haut, bas, gauche, droite, 4 diagonales)
-    int directions[8][2] = {
-        {1, 0},   // bas
-        {-1, 0},  // haut
-        {0, 1},   // droite
-        {0, -1},  // gauche
-        {1, 1},   // diag bas-droite
-        {1, -1},  // diag bas-gauche
-        {-1, 1},  // diag haut-droite
-        {-1, -1}  // diag haut-gauche
-    };
-
-    // Vérifier le pattern (pion)(adversaire)(adversaire)(pion)
-    for (int i = 0; i < 8; i++) {
-        int dx = directions[i][0];
-        int dy = directions[i][1];
-
-        int x1 = ligne + dx;
-        int y1 = colonne + dy;
-        int x2 = x1 + dx;
-        int y2 = y1 + dy;
-        int x3 = x2 + dx;
-        int y3 = y2 + dy;
-
-        // On n'utilise pas continue, on englobe la suite dans un if
-        if (position_valide(x1, y1) &&
-            position_valide(x2, y2) &&
-            position_valide(x3, y3))
-        {
-            // Pattern exact : (symbole, adversaire, adversaire, symbole)
-            if (p->plateau[x1][y1].symbole == adversaire &&
-                p->plateau[x2][y2].symbole == adversaire &&
-                p->plateau[x3][y3].symbole == symbole) {
-
-                // On supprime les 2 pions adverses
-                p->plateau[x1][y1].symbole = '.';
-                p->plateau[x2][y2].symbole = '.';
-
-                // Incrémenter les prises
-                if (symbole == 'X') {
-                    p->prises_joueur_X += 2;
-                } else {
-                    p->prises_joueur_O += 2;
-                }
-            }
+ *    joueur, adversaire : bitboards des pions des deux joueurs
+ *    i                  : bit de la case posée
+ *    pas                : pas de la direction testée (+ ou -)
+ *    motifs             : cases de prise dans cette direction
+ * -------------------------------------------------------
+ */
+int verifier_prise(Plateau *p, int ligne, int colonne, char symbole) {
+    Bitboard *joueur = pions_joueur(p, symbole);
+    Bitboard *adversaire = pions_joueur(p, (symbole == 'X') ? 'O' : 'X');
+    int i = bit_case(ligne, colonne);
+    int sens = 0;
+
+    // 8 directions : les 4 pas, dans les deux sens ; les
+    // motifs de deux sens différents ne partagent aucune case
+    for (int d = 0; d < 8; d++) {
+        int pas = pas_sens(d);
+
+        // Pattern exact : (symbole, adversaire, adversaire, symbole)
+        Bitboard motifs = prises(joueur, adversaire, pas);
+        if (tester_bit(&motifs, i)) {
+            // On supprime les 2 pions adverses
+            int j = (symbole == 'X') ? 0 : 1;
+            basculer_case(p, i + pas, 1 - j);
+            basculer_case(p, i + 2 * pas, 1 - j);
+            p->cle ^= ZOBRIST_PIONS[1 - j][i + pas] ^ ZOBRIST_PIONS[1 - j][i + 2 * pas];
+
+            // Incrémenter les prises
+            int *prises_joueur = (symbole == 'X') ? &p->prises_joueur_X : &p->prises_joueur_O;
+            p->cle ^= zobrist_prises(j, *prises_joueur) ^ zobrist_prises(j, *prises_joueur + 2);
+            *prises_joueur += 2;
+            sens |= 1 << d;
         }
     }
+    return sens;
 }
 
 
-/**
+/*
+ * Structure : Annulation
+ * ----------------------
+ *  - Rôle : ce qu'il faut pour défaire un coup joué par jouer_coup
+ *           (16 octets, une par demi-coup de la recherche)
+ *  - Attributs :
+ *      cle        : clé de Zobrist avant le coup
+ *      case_jouee : bit de la case posée
+ *      sens       : sens des paires prises (résultat de verifier_prise)
+ *      joueur     : 'X' ou 'O'
+ */
+typedef struct {
+    uint64_t cle;
+    int16_t  case_jouee;
+    uint8_t  sens;
+    char     joueur;
+} Annulation;
+
+/*
  * -------------------------------------------------------
- *  Fonction : tour_de_jeu
+ * Fonction: jouer_coup
  * -------------------------------------------------------
- *  Rôle :
- *    - Demander au joueur en cours de saisir un coup
- *    - Gérer l'abandon si (0,0)
- *    - Placer le pion si possible
- *    - Vérifier les prises et l’alignement
- *  donnés :
- *    - plateau : pointeur vers la structure du plateau
- *    - joueur  : chaine de caractère représentant le joueur ('O' ou 'X')
- *  Variables Locales :
- *    - ligne,colonne: entier représentant les lignes et les colennes du plateau
- *    - ch: entier pour vider le buffer
- *  resultat :
- *    -  0 si le coup est normal et la partie continue
- *    -  1 si le joueur a gagné (par alignement ou par 10 prises)
- *    - -1 si le joueur abandonne
+ * Nature       : Fonction
+ * But          : Jouer le coup (ligne, colonne) de 'joueur'
+ *                sur place : pose, prises, détection de la
+ *                victoire, comme tour_de_jeu, en notant dans
+ *                *a de quoi l'annuler
+ * Données      : p (plateau modifié), ligne, colonne,
+ *                joueur, a (annulation remplie)
+ * Résultat     : -1 si la case est invalide ou occupée
+ *                (rien n'est joué), 1 si le coup gagne
+ *                (alignement ou 10 prises), 0 sinon
  * -------------------------------------------------------
  */
-int tour_de_jeu(Plateau *plateau, char joueur) {
-    // Affiche l’état actuel (on peut le faire ici ou dans main)
-    afficher_plateau(plateau);
-
-    // Demander le coup
-    printf("Joueur %c, entrez votre coup (ligne,colonne) [0,0 pour abandon] : ", joueur);
-    int ligne, colonne;
-
-    // Vérifier la validité du format
-    if (scanf("%d,%d", &ligne, &colonne) != 2) {
-        // Mauvais format => on ignore ce tour et on retourne 0 (continuer)
-        printf("Format invalide! (ex: 5,10)\n");
-        // Vider le buffer
-        // si on ne vide pas le buffer dans le cas d'une mauvaise saisie 5,99 et d'un correction par la suite en 5,9 le code prendra 5,5
-        int ch;
-        while ((ch = getchar()) != '\n' && ch != EOF) {}
-        return 0;
+int jouer_coup(Plateau *p, int ligne, int colonne, char joueur, Annulation *a) {
+    a->cle = p->cle;
+    if (!placer_pion(p, ligne, colonne, joueur)) {
+        return -1;
+    }
+    a->case_jouee = (int16_t)bit_case(ligne, colonne);
+    a->joueur = joueur;
+    a->sens = (uint8_t)verifier_prise(p, ligne, colonne, joueur);
+    int prises_joueur = (joueur == 'X') ? p->prises_joueur_X : p->prises_joueur_O;
+    if (prises_joueur >= PRISES_VICTOIRE || verifier_alignement(p, ligne, colonne, joueur)) {
+        return 1;
     }
+    return 0;
+}
 
-    // Abandon
-    if (ligne == 0 && colonne == 0) {
-        return -1; // signal d'abandon
+/*
+ * -------------------------------------------------------
+ * action : annuler_coup
+ * -------------------------------------------------------
+ * But          : Défaire le dernier coup joué par jouer_coup
+ *                (les annulations se défont dans l'ordre
+ *                inverse des coups) : les paires prises
+ *                reviennent, le pion posé est retiré, les
+ *                prises et la clé retrouvent leur valeur
+ * Données      : p (plateau), a (annulation du coup)
+ * -------------------------------------------------------
+ */
+void annuler_coup(Plateau *p, const Annulation *a) {
+    int i = a->case_jouee;
+    int j = (a->joueur == 'X') ? 0 : 1;
+    for (int d = 0; d < 8; d++) {
+        if (a->sens & (1 << d)) {
+            basculer_case(p, i + pas_sens(d), 1 - j);
+            basculer_case(p, i + 2 * pas_sens(d), 1 - j);
+        }
     }
+    int *prises_joueur = (a->joueur == 'X') ? &p->prises_joueur_X : &p->prises_joueur_O;
+    *prises_joueur -= 2 * __builtin_popcount(a->sens);
+    basculer_case(p, i, j);
+    p->cle = a->cle;
+}
 
-    // Conversion indices (1..19) -> (0..18)
-    ligne   -= 1;
-    colonne -= 1;
 
-    // Placer le pion si possible
-    if (!placer_pion(plateau, ligne, colonne, joueur)) {
-        printf("Coup invalide (hors-limites ou case non vide). Réessayez.\n");
-        return 0;
-    }
+/*******************************************************
+ *  Adversaire artificiel : negamax alpha-bêta à
+ *  approfondissement itératif
+ *******************************************************/
+#define PROFONDEUR_MAX  32
+#define SCORE_INFINI    1000000000
+#define SCORE_VICTOIRE  100000000   // moins la distance en demi-coups
+#define THREADS_MAX     64
 
-    // Vérifier si on capture des pions
-    verifier_prise(plateau, ligne, colonne, joueur);
+/*
+ * Structure : Budget
+ * ------------------
+ *  - Rôle : limites d'une recherche (0 : pas de limite)
+ *  - Attributs :
+ *      temps      : durée maximale en secondes
+ *      noeuds     : nombre maximal de positions visitées
+ *      profondeur : profondeur maximale (PROFONDEUR_MAX au plus)
+ */
+typedef struct {
+    double temps;
+    long long noeuds;
+    int profondeur;
+} Budget;
 
-    // Vérifier alignement >= 5
-    if (verifier_alignement(plateau, ligne, colonne, joueur)) {
-        return 1; // alignement => victoire
-    }
+/*
+ * Structure : Recherche
+ * ---------------------
+ *  - Rôle : état d'une recherche en cours
+ *  - Attributs :
+ *      budget      : limites demandées
+ *      debut       : instant de départ (secondes)
+ *      noeuds      : positions visitées
+ *      interrompue : budget épuisé, l'itération en cours est abandonnée
+ *      arret       : drapeau partagé par les threads d'une même recherche,
+ *                    levé quand le thread principal a fini
+ *      aide        : thread auxiliaire (Lazy SMP) : ne consulte que arret
+ *      historique  : score des coups ayant provoqué une coupure, par
+ *                    joueur (0 : X, 1 : O) et par case, pour trier les coups
+ */
+typedef struct {
+    Budget budget;
+    double debut;
+    long long noeuds;
+    bool interrompue;
+    _Atomic bool *arret;
+    bool aide;
+    int historique[2][NB_CASES_BITS];
+} Recherche;
 
-    // Vérifier victoire par 10 prises
-    if (plateau->prises_joueur_X >= 10) {
-        if (joueur == 'X') {
-            return 1; // X gagne
-        }
-    }
-    if (plateau->prises_joueur_O >= 10) {
-        if (joueur == 'O') {
-            return 1; // O gagne
+/*
+ * -------------------------------------------------------
+ * Fonction: horloge
+ * -------------------------------------------------------
+ * But          : Horloge monotone en secondes
+ * -------------------------------------------------------
+ */
+static double horloge(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+/*
+ * -------------------------------------------------------
+ * Fonction: masque_cases
+ * -------------------------------------------------------
+ * But          : Bitboard des 361 cases du plateau (sans
+ *                les colonnes de garde), calculé une fois
+ * -------------------------------------------------------
+ */
+static const Bitboard *masque_cases(void) {
+    static Bitboard masque;
+    static bool pret = false;
+    if (!pret) {
+        for (int i = 0; i < TAILLE_PLATEAU; i++) {
+            for (int j = 0; j < TAILLE_PLATEAU; j++) {
+                poser_bit(&masque, bit_case(i, j));
+            }
         }
+        pret = true;
     }
-
-    return 0; // pas de victoire ni d'abandon => la partie continue
+    return &masque;
 }
 
-
-/**
+/*
  * -------------------------------------------------------
- *  Fonction principale : main
+ * Fonction: compter_bits
  * -------------------------------------------------------
- *  Rôle :
- *    - Créer et initialiser le plateau
- *    - Déterminer qui commence ('O')
- *    - Gérer la boucle de jeu (appels successifs à tour_de_jeu)
- *    - Annoncer le vainqueur ou l'abandon
+ * But          : Nombre de bits à 1 d'un bitboard
  * -------------------------------------------------------
  */
-int main() {
+static inline int compter_bits(const Bitboard *b) {
+    int n = 0;
+    for (int i = 0; i < NB_MOTS; i++) {
+        n += __builtin_popcountll(b->mots[i]);
+    }
+    return n;
+}
+
+/*
+ * -------------------------------------------------------
+ * Fonction: evaluer
+ * -------------------------------------------------------
+ * But          : Score statique de la position du point de
+ *                vue de 'joueur' : valeur des motifs des
+ *                lignes (tenue à jour à chaque pose et prise,
+ *                rien n'est reparcouru ici) et prises (chaque
+ *                paire rapproche de 10)
+ * -------------------------------------------------------
+ */
+static int evaluer(const Plateau *p, char joueur) {
+    int x = p->prises_joueur_X, o = p->prises_joueur_O;
+    int score = p->evaluation + 150 * (x * x - o * o);
+    return (joueur == 'X') ? score : -score;
+}
+
+/*
+ * -------------------------------------------------------
+ * Fonction: generer_coups
+ * -------------------------------------------------------
+ * Nature       : Fonction
+ * But          : Cases libres à distance au plus 2 d'un pion
+ *                (dilatation du plateau par décalages), ou le
+ *                centre sur un plateau vide
+ * Données      : p (plateau), coups (tableau de sortie,
+ *                bits des cases)
+ * Résultat     : nombre de coups
+ * -------------------------------------------------------
+ */
+static int generer_coups(const Plateau *p, int *coups) {
+    Bitboard occupees, voisines;
+    for (int i = 0; i < NB_MOTS; i++) {
+        occupees.mots[i] = p->pions_X.mots[i] | p->pions_O.mots[i];
+    }
+    voisines = occupees;
+    for (int rayon = 0; rayon < 2; rayon++) {
+        Bitboard source = voisines;
+        for (int d = 0; d < 8; d++) {
+            Bitboard b = decaler(&source, pas_sens(d));
+            for (int i = 0; i < NB_MOTS; i++) {
+                voisines.mots[i] |= b.mots[i];
+            }
+        }
+        // les gardes ne doivent pas propager la dilatation d'une ligne à l'autre
+        et_bitboard(&voisines, masque_cases());
+    }
+    int n = 0;
+    for (int i = 0; i < NB_MOTS; i++) {
+        uint64_t m = voisines.mots[i] & ~occupees.mots[i];
+        while (m) {
+            coups[n++] = i * 64 + __builtin_ctzll(m);
+            m &= m - 1;
+        }
+    }
+    if (n == 0 && compter_bits(&occupees) == 0) {
+        coups[n++] = bit_case(TAILLE_PLATEAU / 2, TAILLE_PLATEAU / 2);
+    }
+    return n;
+}
+
+/*
+ * -------------------------------------------------------
+ * action : trier_coups
+ * -------------------------------------------------------
+ * But          : Ordonne les coups par historique
+ *                décroissant, le coup 'premier' (meilleur
+ *                coup de l'itération précédente) en tête
+ * -------------------------------------------------------
+ */
+static void trier_coups(const Recherche *r, char joueur, int *coups, int n, int premier) {
+    const int *h = r->historique[joueur == 'X' ? 0 : 1];
+    int cles[TAILLE_PLATEAU * TAILLE_PLATEAU];
+    for (int k = 0; k < n; k++) {
+        cles[k] = (coups[k] == premier) ? SCORE_INFINI : h[coups[k]];
+    }
+    // tri par insertion : les listes sont courtes et presque triées
+    for (int k = 1; k < n; k++) {
+        int c = coups[k], v = cles[k], j = k - 1;
+        while (j >= 0 && cles[j] < v) {
+            coups[j + 1] = coups[j];
+            cles[j + 1] = cles[j];
+            j--;
+        }
+        coups[j + 1] = c;
+        cles[j + 1] = v;
+    }
+}
+
+/*
+ * -------------------------------------------------------
+ * Fonction: budget_epuise
+ * -------------------------------------------------------
+ * But          : Vrai si la recherche dépasse son budget
+ *                de temps ou de noeuds, ou si le thread
+ *                principal a fini
+ * -------------------------------------------------------
+ */
+static bool budget_epuise(const Recherche *r) {
+    if (atomic_load_explicit(r->arret, memory_order_relaxed)) return true;
+    if (r->aide) return false;
+    if (r->budget.noeuds > 0 && r->noeuds >= r->budget.noeuds) return true;
+    return r->budget.temps > 0 && horloge() - r->debut >= r->budget.temps;
+}
+
+/*
+ * Table de transposition
+ * ----------------------
+ *  - TT_SEAUX seaux d'une ligne de cache (64 octets), chacun de
+ *    TT_ENTREES entrées de 16 octets ; la clé de Zobrist choisit le seau
+ *  - une entrée est deux mots atomiques : donnees (score, profondeur,
+ *    borne, meilleur coup, génération) et cle_xor = cle ^ donnees ;
+ *    une lecture n'est acceptée que si cle_xor ^ donnees redonne la clé,
+ *    si bien qu'une entrée à moitié réécrite par un autre thread est
+ *    simplement ignorée : ni verrou, ni barrière, accès relâchés
+ *  - remplacement : l'entrée de même clé, sinon celle d'une recherche
+ *    précédente (génération), sinon la moins profonde
+ */
+#define TT_SEAUX_LOG2 18              // 2^18 seaux de 64 octets : 16 Mo
+#define TT_SEAUX      (1u << TT_SEAUX_LOG2)
+#define TT_ENTREES    4
+
+enum { BORNE_EXACTE = 1, BORNE_INF = 2, BORNE_SUP = 3 };
+
+typedef struct {
+    _Atomic uint64_t cle_xor;
+    _Atomic uint64_t donnees;
+} EntreeTT;
+
+typedef struct {
+    alignas(64) EntreeTT entrees[TT_ENTREES];
+} SeauTT;
+
+/*
+ * Structure : LectureTT
+ * ---------------------
+ *  - Rôle : contenu décodé d'une entrée de la table
+ *  - Attributs : score (relatif au noeud), profondeur, borne
+ *    (BORNE_*), coup (bit de la case, -1 si aucun)
+ */
+typedef struct {
+    int score, profondeur, borne, coup;
+} LectureTT;
+
+static SeauTT *table_tt = NULL;
+static _Atomic unsigned generation_tt = 0;
+
+/*
+ * -------------------------------------------------------
+ * Fonction: initialiser_table
+ * -------------------------------------------------------
+ * But          : Alloue la table de transposition (vide),
+ *                alignée sur une ligne de cache
+ * Résultat     : false si la mémoire manque (l'IA joue
+ *                alors sans table)
+ * -------------------------------------------------------
+ */
+bool initialiser_table(void) {
+    if (table_tt) return true;
+    table_tt = aligned_alloc(64, (size_t)TT_SEAUX * sizeof(SeauTT));
+    if (!table_tt) return false;
+    memset(table_tt, 0, (size_t)TT_SEAUX * sizeof(SeauTT));
+    return true;
+}
+
+// table vidée : chaque mesure du banc d'essai part de zéro
+static void vider_table(void) {
+    if (table_tt) memset(table_tt, 0, (size_t)TT_SEAUX * sizeof(SeauTT));
+}
+
+// les scores de victoire sont stockés relativement au noeud, pas à la racine
+static inline int score_vers_tt(int score, int ply) {
+    if (score >= SCORE_VICTOIRE - 2 * PROFONDEUR_MAX) return score + ply;
+    if (score <= -SCORE_VICTOIRE + 2 * PROFONDEUR_MAX) return score - ply;
+    return score;
+}
+
+static inline int score_depuis_tt(int score, int ply) {
+    if (score >= SCORE_VICTOIRE - 2 * PROFONDEUR_MAX) return score - ply;
+    if (score <= -SCORE_VICTOIRE + 2 * PROFONDEUR_MAX) return score + ply;
+    return score;
+}
+
+/*
+ * -------------------------------------------------------
+ * Fonction: sonder_tt
+ * -------------------------------------------------------
+ * But          : Cherche la position 'cle' dans son seau
+ * Résultat     : true (et *e rempli) si elle y est
+ * -------------------------------------------------------
+ */
+static bool sonder_tt(uint64_t cle, int ply, LectureTT *e) {
+    if (!table_tt) return false;
+    SeauTT *seau = &table_tt[cle & (TT_SEAUX - 1)];
+    for (int k = 0; k < TT_ENTREES; k++) {
+        uint64_t d = atomic_load_explicit(&seau->entrees[k].donnees, memory_order_relaxed);
+        uint64_t c = atomic_load_explicit(&seau->entrees[k].cle_xor, memory_order_relaxed);
+        if ((c ^ d) == cle) {
+            e->score = score_depuis_tt((int32_t)(uint32_t)d, ply);
+            e->profondeur = (int)((d >> 32) & 0xFF);
+            e->borne = (int)((d >> 40) & 3);
+            e->coup = (int)((d >> 42) & 0x1FF) - 1;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * -------------------------------------------------------
+ * action : stocker_tt
+ * -------------------------------------------------------
+ * But          : Enregistre le résultat d'une recherche de
+ *                la position 'cle' (voir remplacement plus haut)
+ * -------------------------------------------------------
+ */
+static void stocker_tt(uint64_t cle, int ply, int profondeur, int borne, int score, int coup) {
+    if (!table_tt) return;
+    unsigned generation = atomic_load_explicit(&generation_tt, memory_order_relaxed) & 0x3F;
+    uint64_t d = (uint64_t)(uint32_t)score_vers_tt(score, ply)
+               | (uint64_t)(profondeur & 0xFF) << 32
+               | (uint64_t)borne << 40
+               | (uint64_t)(coup + 1) << 42
+               | (uint64_t)generation << 51;
+    SeauTT *seau = &table_tt[cle & (TT_SEAUX - 1)];
+    int cible = 0, pire = INT32_MAX;
+    for (int k = 0; k < TT_ENTREES; k++) {
+        uint64_t dk = atomic_load_explicit(&seau->entrees[k].donnees, memory_order_relaxed);
+        uint64_t ck = atomic_load_explicit(&seau->entrees[k].cle_xor, memory_order_relaxed);
+        if ((ck ^ dk) == cle) {
+            cible = k;
+            break;
+        }
+        // valeur d'une entrée : sa profondeur, moins une grosse pénalité si elle est ancienne
+        int valeur = (int)((dk >> 32) & 0xFF) - ((((dk >> 51) & 0x3F) != generation) ? 256 : 0);
+        if (valeur < pire) {
+            pire = valeur;
+            cible = k;
+        }
+    }
+    atomic_store_explicit(&seau->entrees[cible].donnees, d, memory_order_relaxed);
+    atomic_store_explicit(&seau->entrees[cible].cle_xor, cle ^ d, memory_order_relaxed);
+}
+
+/*
+ * -------------------------------------------------------
+ * Fonction: negamax
+ * -------------------------------------------------------
+ * Nature       : Fonction récursive
+ * But          : Score de la position pour 'joueur' (qui
+ *                doit jouer) à 'profondeur' demi-coups,
+ *                par alpha-bêta ; une victoire vaut
+ *                SCORE_VICTOIRE moins sa distance 'ply'
+ * Données      : r (recherche), p (plateau), joueur,
+ *                profondeur, alpha, beta, ply
+ * Résultat     : score (0 si la recherche est interrompue)
+ * -------------------------------------------------------
+ */
+static int negamax(Recherche *r, Plateau *p, char joueur, int profondeur, int alpha, int beta, int ply) {
+    r->noeuds++;
+    // les feuilles ne consultent pas le budget : l'itération de
+    // profondeur 1, faite de feuilles, va toujours à son terme
+    if (profondeur > 0 && (r->noeuds & 1023) == 0 && budget_epuise(r)) {
+        r->interrompue = true;
+    }
+    if (r->interrompue) return 0;
+    if (profondeur == 0) return evaluer(p, joueur);
+
+    // une recherche au moins aussi profonde de la même position
+    // donne le score ou resserre la fenêtre
+    LectureTT tt;
+    int coup_tt = -1, alpha_initial = alpha;
+    if (sonder_tt(p->cle, ply, &tt)) {
+        coup_tt = tt.coup;
+        if (tt.profondeur >= profondeur) {
+            if (tt.borne == BORNE_EXACTE) return tt.score;
+            if (tt.borne == BORNE_INF && tt.score > alpha) alpha = tt.score;
+            if (tt.borne == BORNE_SUP && tt.score < beta) beta = tt.score;
+            if (alpha >= beta) return tt.score;
+        }
+    }
+
+    int coups[TAILLE_PLATEAU * TAILLE_PLATEAU];
+    int n = generer_coups(p, coups);
+    if (n == 0) return 0;  // plateau plein : match nul
+    trier_coups(r, joueur, coups, n, coup_tt);
+
+    char adversaire = (joueur == 'X') ? 'O' : 'X';
+    int meilleur = -SCORE_INFINI, meilleur_coup = coups[0];
+    for (int k = 0; k < n; k++) {
+        Annulation a;
+        int score;
+        if (jouer_coup(p, coups[k] / LARGEUR_LIGNE, coups[k] % LARGEUR_LIGNE, joueur, &a) == 1) {
+            score = SCORE_VICTOIRE - ply - 1;
+        } else {
+            score = -negamax(r, p, adversaire, profondeur - 1, -beta, -alpha, ply + 1);
+        }
+        annuler_coup(p, &a);
+        if (r->interrompue) return 0;
+        if (score > meilleur) {
+            meilleur = score;
+            meilleur_coup = coups[k];
+        }
+        if (score > alpha) alpha = score;
+        if (alpha >= beta) {
+            r->historique[joueur == 'X' ? 0 : 1][coups[k]] += profondeur * profondeur;
+            break;
+        }
+    }
+    int borne = (meilleur <= alpha_initial) ? BORNE_SUP : (meilleur >= beta) ? BORNE_INF : BORNE_EXACTE;
+    stocker_tt(p->cle, ply, profondeur, borne, meilleur, meilleur_coup);
+    return meilleur;
+}
+
+/*
+ * -------------------------------------------------------
+ * Fonction: approfondir
+ * -------------------------------------------------------
+ * Nature       : Fonction
+ * But          : Approfondissement itératif depuis p :
+ *                negamax à profondeur depart, depart + 1, ...
+ *                jusqu'à épuisement du budget ou à la
+ *                profondeur maximale ; le coup retenu est
+ *                celui de la dernière itération complète
+ *                (la première l'est toujours sauf pour un
+ *                thread auxiliaire arrêté)
+ * Données      : r (recherche), p (plateau), joueur, depart
+ * Résultats    : profondeur atteinte
+ * Résultat     : bit de la case retenue, -1 si aucune case
+ *                n'est libre
+ * -------------------------------------------------------
+ */
+static int approfondir(Recherche *r, const Plateau *p, char joueur, int depart, int *profondeur) {
+    Plateau q = *p;  // seule copie : la recherche joue et défait ses coups dessus
+    int coups[TAILLE_PLATEAU * TAILLE_PLATEAU];
+    int n = generer_coups(p, coups);
+    if (n == 0) return -1;
+    char adversaire = (joueur == 'X') ? 'O' : 'X';
+    int meilleur_coup = coups[0];
+    *profondeur = 0;
+    LectureTT tt;
+    if (sonder_tt(p->cle, 0, &tt) && tt.coup >= 0) {
+        for (int k = 0; k < n; k++) {
+            if (coups[k] == tt.coup) meilleur_coup = tt.coup;
+        }
+    }
+
+    int limite = (r->budget.profondeur > 0 && r->budget.profondeur < PROFONDEUR_MAX) ? r->budget.profondeur
+                                                                                    : PROFONDEUR_MAX;
+    for (int prof = depart; prof <= limite; prof++) {
+        trier_coups(r, joueur, coups, n, meilleur_coup);
+        int alpha = -SCORE_INFINI, coup_iteration = coups[0];
+        for (int k = 0; k < n && !r->interrompue; k++) {
+            Annulation a;
+            int score;
+            if (jouer_coup(&q, coups[k] / LARGEUR_LIGNE, coups[k] % LARGEUR_LIGNE, joueur, &a) == 1) {
+                score = SCORE_VICTOIRE - 1;
+            } else {
+                score = -negamax(r, &q, adversaire, prof - 1, -SCORE_INFINI, -alpha, 1);
+            }
+            annuler_coup(&q, &a);
+            if (!r->interrompue && score > alpha) {
+                alpha = score;
+                coup_iteration = coups[k];
+            }
+        }
+        if (r->interrompue) break;
+        meilleur_coup = coup_iteration;
+        *profondeur = prof;
+        stocker_tt(p->cle, 0, prof, BORNE_EXACTE, alpha, meilleur_coup);
+        // victoire ou défaite forcée : inutile d'aller plus loin
+        if (alpha >= SCORE_VICTOIRE - PROFONDEUR_MAX || alpha <= -SCORE_VICTOIRE + PROFONDEUR_MAX) break;
+        if (budget_epuise(r)) break;
+    }
+    return meilleur_coup;
+}
+
+/*
+ * Structure : AideSMP
+ * -------------------
+ *  - Rôle : thread auxiliaire de Lazy SMP
+ *  - Attributs : r (sa recherche, son historique), p (position de
+ *    la racine), joueur, depart (première profondeur)
+ */
+typedef struct {
+    Recherche r;
+    const Plateau *p;
+    char joueur;
+    int depart;
+} AideSMP;
+
+static void *lancer_aide(void *arg) {
+    AideSMP *aide = arg;
+    int profondeur;
+    approfondir(&aide->r, aide->p, aide->joueur, aide->depart, &profondeur);
+    return NULL;
+}
+
+/*
+ * -------------------------------------------------------
+ * Fonction: choisir_coup
+ * -------------------------------------------------------
+ * Nature       : Fonction
+ * But          : Coup de 'joueur' par approfondissement
+ *                itératif ; avec plusieurs threads (Lazy
+ *                SMP), des threads auxiliaires cherchent la
+ *                même racine, un sur deux avec une profondeur
+ *                d'avance, sans autre lien que la table de
+ *                transposition partagée ; seul le résultat du
+ *                thread principal compte, et sa fin arrête
+ *                les autres
+ * Données      : p (plateau), joueur, budget, threads
+ * Résultats    : ligne, colonne (0..18), profondeur
+ *                atteinte, noeuds visités (tous threads)
+ * Résultat     : false si aucune case n'est libre
+ * -------------------------------------------------------
+ */
+bool choisir_coup(const Plateau *p, char joueur, const Budget *budget, int threads,
+                  int *ligne, int *colonne, int *profondeur, long long *noeuds) {
+    _Atomic bool arret = false;
+    Recherche r = { .budget = *budget, .debut = horloge(), .arret = &arret };
+    // nouvelle génération : les entrées des coups précédents restent
+    // lisibles mais sont remplacées en priorité
+    atomic_fetch_add_explicit(&generation_tt, 1, memory_order_relaxed);
+
+    pthread_t fils[THREADS_MAX];
+    AideSMP *aides = (threads > 1) ? calloc((size_t)threads - 1, sizeof(AideSMP)) : NULL;
+    int lances = 0;
+    for (int t = 0; aides && t < threads - 1; t++) {
+        aides[lances] = (AideSMP){ .r = { .budget = *budget, .debut = r.debut, .arret = &arret, .aide = true },
+                                   .p = p, .joueur = joueur, .depart = 1 + (lances % 2 == 0) };
+        if (pthread_create(&fils[lances], NULL, lancer_aide, &aides[lances]) == 0) lances++;
+    }
+
+    int coup = approfondir(&r, p, joueur, 1, profondeur);
+    atomic_store_explicit(&arret, true, memory_order_relaxed);
+    *noeuds = r.noeuds;
+    for (int t = 0; t < lances; t++) {
+        pthread_join(fils[t], NULL);
+        *noeuds += aides[t].r.noeuds;
+    }
+    free(aides);
+    if (coup < 0) return false;
+
+    *ligne = coup / LARGEUR_LIGNE;
+    *colonne = coup % LARGEUR_LIGNE;
+    return true;
+}
+
+
+/*******************************************************
+ *  Adversaire artificiel : recherche arborescente de
+ *  Monte-Carlo (MCTS) parallèle
+ *******************************************************/
+/*
+ * Principe
+ * --------
+ *  - chaque simulation descend l'arbre par UCT, développe la feuille
+ *    atteinte si elle a été visitée MCTS_SEUIL fois, finit la partie au
+ *    hasard (pions posés près des pions existants) et remonte le
+ *    résultat : 2 demi-points au vainqueur, 1 à chacun en cas de nul
+ *  - parallélisme sur l'arbre : tous les threads partagent le même
+ *    arbre ; les compteurs sont atomiques et un seul thread développe
+ *    un noeud (etat A_DEVELOPPER -> EN_DEVELOPPEMENT -> DEVELOPPE)
+ *  - perte virtuelle : une visite est comptée dès la descente et son
+ *    gain seulement au retour ; une simulation en cours compte donc
+ *    comme une défaite et écarte les autres threads de son chemin
+ *  - les noeuds viennent d'une réserve préallouée (indices, enfants
+ *    contigus) : pas de malloc par noeud ; réserve pleine, les feuilles
+ *    ne sont plus développées et la recherche continue
+ *  - réutilisation : au coup suivant, le noeud de la nouvelle position
+ *    (racine, enfant ou petit-enfant de même clé de Zobrist) est recopié
+ *    avec son sous-arbre en tête de la seconde réserve, qui devient la
+ *    réserve courante
+ */
+#define MCTS_NOEUDS      (1u << 20)   // noeuds de 32 octets par réserve : 32 Mo
+#define MCTS_SEUIL       8            // visites avant de développer une feuille
+#define MCTS_EXPLORATION 0.8          // constante d'exploration d'UCT
+#define MCTS_CHEMIN_MAX  512          // profondeur maximale d'une descente
+#define MCTS_AUCUN       UINT32_MAX
+
+enum { A_DEVELOPPER, EN_DEVELOPPEMENT, DEVELOPPE };
+
+/*
+ * Structure : NoeudMCTS
+ * ---------------------
+ *  - Rôle : position de l'arbre, atteinte par 'coup'
+ *  - Attributs :
+ *      visites        : simulations passées par le noeud (en cours comprises)
+ *      gains          : demi-points du joueur qui a joué 'coup'
+ *      cle            : clé de Zobrist de la position
+ *      premier_enfant : indice du premier enfant dans la réserve
+ *      nb_enfants     : nombre d'enfants (0 : plateau plein)
+ *      coup           : bit de la case jouée
+ *      etat           : A_DEVELOPPER, EN_DEVELOPPEMENT ou DEVELOPPE
+ *      gagnant        : le coup gagne la partie (noeud terminal)
+ */
+typedef struct {
+    _Atomic uint32_t visites;
+    _Atomic uint32_t gains;
+    uint64_t cle;
+    uint32_t premier_enfant;
+    uint16_t nb_enfants;
+    int16_t coup;
+    _Atomic uint8_t etat;
+    uint8_t gagnant;
+} NoeudMCTS;
+
+/*
+ * Structure : ArbreMCTS
+ * ---------------------
+ *  - Rôle : arbre partagé par les threads d'une recherche
+ *  - Attributs :
+ *      reserves    : réserve courante (indice courante) et réserve de
+ *                    recopie ; la racine est le noeud 0
+ *      utilises    : noeuds alloués dans la réserve courante
+ *      racine      : position de la racine, trait : joueur qui doit jouer
+ *      budget      : limites (noeuds : nombre de simulations)
+ *      debut       : instant de départ (secondes)
+ *      simulations : simulations terminées pendant cette recherche
+ *      arret       : budget épuisé, les threads s'arrêtent
+ */
+typedef struct {
+    NoeudMCTS *reserves[2];
+    int courante;
+    _Atomic uint32_t utilises;
+    Plateau racine;
+    char trait;
+    Budget budget;
+    double debut;
+    _Atomic long long simulations;
+    _Atomic bool arret;
+} ArbreMCTS;
+
+static ArbreMCTS arbre_mcts;
+
+/*
+ * -------------------------------------------------------
+ * Fonction: initialiser_mcts
+ * -------------------------------------------------------
+ * But          : Alloue les deux réserves de noeuds, arbre
+ *                vide
+ * Résultat     : false si la mémoire manque
+ * -------------------------------------------------------
+ */
+bool initialiser_mcts(void) {
+    if (arbre_mcts.reserves[0]) return true;
+    for (int k = 0; k < 2; k++) {
+        arbre_mcts.reserves[k] = malloc((size_t)MCTS_NOEUDS * sizeof(NoeudMCTS));
+        if (!arbre_mcts.reserves[k]) return false;
+    }
+    atomic_init(&arbre_mcts.utilises, 0);
+    return true;
+}
+
+// suite xorshift64* propre à chaque thread
+static inline uint64_t aleatoire(uint64_t *etat) {
+    *etat ^= *etat >> 12;
+    *etat ^= *etat << 25;
+    *etat ^= *etat >> 27;
+    return *etat * 0x2545F4914F6CDD1Du;
+}
+
+/*
+ * -------------------------------------------------------
+ * Fonction: allouer_noeuds
+ * -------------------------------------------------------
+ * But          : Réserve n noeuds contigus, sans verrou
+ * Résultat     : indice du premier, MCTS_AUCUN si la
+ *                réserve est pleine
+ * -------------------------------------------------------
+ */
+static uint32_t allouer_noeuds(ArbreMCTS *a, uint32_t n) {
+    // test préalable : une réserve pleine ne voit plus son compteur grossir
+    if (atomic_load_explicit(&a->utilises, memory_order_relaxed) + n > MCTS_NOEUDS) return MCTS_AUCUN;
+    uint32_t premier = atomic_fetch_add_explicit(&a->utilises, n, memory_order_relaxed);
+    return (premier + n <= MCTS_NOEUDS) ? premier : MCTS_AUCUN;
+}
+
+static void preparer_noeud(NoeudMCTS *n, uint64_t cle, int coup, bool gagnant) {
+    atomic_init(&n->visites, 0);
+    atomic_init(&n->gains, 0);
+    n->cle = cle;
+    n->premier_enfant = MCTS_AUCUN;
+    n->nb_enfants = 0;
+    n->coup = (int16_t)coup;
+    atomic_init(&n->etat, A_DEVELOPPER);
+    n->gagnant = gagnant;
+}
+
+/*
+ * -------------------------------------------------------
+ * action : developper
+ * -------------------------------------------------------
+ * But          : Crée les enfants du noeud 'indice' (position
+ *                p, 'joueur' au trait) : un par coup de
+ *                generer_coups, ou le seul coup gagnant s'il y
+ *                en a un ; le noeud doit être EN_DEVELOPPEMENT
+ *                et repasse A_DEVELOPPER si la réserve est pleine
+ * Résultat     : true si le noeud est développé
+ * -------------------------------------------------------
+ */
+static bool developper(ArbreMCTS *a, uint32_t indice, Plateau *p, char joueur) {
+    NoeudMCTS *noeuds = a->reserves[a->courante];
+    int coups[TAILLE_PLATEAU * TAILLE_PLATEAU];
+    uint64_t cles[TAILLE_PLATEAU * TAILLE_PLATEAU];
+    int n = generer_coups(p, coups), gagnant = -1;
+    for (int k = 0; k < n && gagnant < 0; k++) {
+        Annulation an;
+        if (jouer_coup(p, coups[k] / LARGEUR_LIGNE, coups[k] % LARGEUR_LIGNE, joueur, &an) == 1) gagnant = k;
+        cles[k] = p->cle;
+        annuler_coup(p, &an);
+    }
+    if (gagnant >= 0) {
+        coups[0] = coups[gagnant];
+        cles[0] = cles[gagnant];
+        n = 1;
+    }
+
+    uint32_t premier = (n > 0) ? allouer_noeuds(a, (uint32_t)n) : 0;
+    if (premier == MCTS_AUCUN) {
+        atomic_store_explicit(&noeuds[indice].etat, A_DEVELOPPER, memory_order_relaxed);
+        return false;
+    }
+    for (int k = 0; k < n; k++) {
+        preparer_noeud(&noeuds[premier + k], cles[k], coups[k], gagnant >= 0);
+    }
+    noeuds[indice].premier_enfant = premier;
+    noeuds[indice].nb_enfants = (uint16_t)n;
+    // publication : qui lit DEVELOPPE voit les enfants
+    atomic_store_explicit(&noeuds[indice].etat, DEVELOPPE, memory_order_release);
+    return true;
+}
+
+/*
+ * -------------------------------------------------------
+ * Fonction: choisir_enfant
+ * -------------------------------------------------------
+ * But          : Enfant de plus grande valeur UCT (moyenne
+ *                des gains + exploration) ; un enfant jamais
+ *                visité passe en premier
+ * -------------------------------------------------------
+ */
+static uint32_t choisir_enfant(const NoeudMCTS *noeuds, const NoeudMCTS *parent) {
+    uint32_t total = atomic_load_explicit(&parent->visites, memory_order_relaxed);
+    double log_total = log((double)(total > 0 ? total : 1));
+    double meilleur = -1.0;
+    uint32_t choix = parent->premier_enfant;
+    for (uint32_t k = 0; k < parent->nb_enfants; k++) {
+        const NoeudMCTS *e = &noeuds[parent->premier_enfant + k];
+        uint32_t v = atomic_load_explicit(&e->visites, memory_order_relaxed);
+        if (v == 0) return parent->premier_enfant + k;
+        uint32_t g = atomic_load_explicit(&e->gains, memory_order_relaxed);
+        double valeur = g / (2.0 * v) + MCTS_EXPLORATION * sqrt(log_total / v);
+        if (valeur > meilleur) {
+            meilleur = valeur;
+            choix = parent->premier_enfant + k;
+        }
+    }
+    return choix;
+}
+
+/*
+ * -------------------------------------------------------
+ * Fonction: coup_simule
+ * -------------------------------------------------------
+ * But          : Version allégée de jouer_coup pour les
+ *                parties au hasard : sur les seuls bitboards,
+ *                sans clé ni évaluation, prises et
+ *                alignement cherchés autour de la case c (les
+ *                colonnes de garde, toujours vides, arrêtent
+ *                les parcours en bout de ligne)
+ * Données      : moi, adv (pions des deux joueurs), prises
+ *                (pions pris par le joueur), c (bit de la case)
+ * Résultat     : true si le coup gagne
+ * -------------------------------------------------------
+ */
+static bool coup_simule(Bitboard *moi, Bitboard *adv, int *prises, int c) {
+    poser_bit(moi, c);
+    for (int d = 0; d < 8; d++) {
+        int pas = pas_sens(d), bout = c + 3 * pas;
+        if (bout >= 0 && bout < NB_CASES_BITS && tester_bit(moi, bout) &&
+            tester_bit(adv, c + pas) && tester_bit(adv, c + 2 * pas)) {
+            effacer_bit(adv, c + pas);
+            effacer_bit(adv, c + 2 * pas);
+            *prises += 2;
+        }
+    }
+    if (*prises >= PRISES_VICTOIRE) return true;
+    for (int d = 0; d < 4; d++) {
+        int pas = PAS_DIRECTIONS[d], n = 1;
+        for (int v = c + pas; v < NB_CASES_BITS && tester_bit(moi, v); v += pas) n++;
+        for (int v = c - pas; v >= 0 && tester_bit(moi, v); v -= pas) n++;
+        if (n >= 5) return true;
+    }
+    return false;
+}
+
+/*
+ * -------------------------------------------------------
+ * Fonction: jouer_au_hasard
+ * -------------------------------------------------------
+ * But          : Termine la partie de p par des coups tirés
+ *                au hasard parmi les cases libres voisines
+ *                (distance 1) d'un pion, toutes les cases
+ *                libres s'il n'y en a pas ; p n'est pas
+ *                modifié
+ * Résultat     : vainqueur ('X' ou 'O'), 0 si match nul
+ * -------------------------------------------------------
+ */
+static char jouer_au_hasard(const Plateau *p, char joueur, uint64_t *graine) {
+    Bitboard pions[2] = { p->pions_X, p->pions_O };
+    int prises[2] = { p->prises_joueur_X, p->prises_joueur_O };
+    int j = (joueur == 'X') ? 0 : 1;
+    Bitboard occupees, zone = { { 0 } };
+    for (int i = 0; i < NB_MOTS; i++) {
+        occupees.mots[i] = pions[0].mots[i] | pions[1].mots[i];
+    }
+    for (int d = 0; d < 8; d++) {
+        Bitboard v = decaler(&occupees, pas_sens(d));
+        for (int i = 0; i < NB_MOTS; i++) {
+            zone.mots[i] |= v.mots[i];
+        }
+    }
+    // les prises libèrent des cases : la partie peut dépasser 361 coups
+    for (int coup = 0; coup < 2 * TAILLE_PLATEAU * TAILLE_PLATEAU; coup++) {
+        Bitboard libres;
+        int n = 0;
+        for (int i = 0; i < NB_MOTS; i++) {
+            libres.mots[i] = masque_cases()->mots[i] & ~(pions[0].mots[i] | pions[1].mots[i]);
+            n += __builtin_popcountll(libres.mots[i] & zone.mots[i]);
+        }
+        if (n > 0) {
+            et_bitboard(&libres, &zone);
+        } else if ((n = compter_bits(&libres)) == 0) {
+            return 0;  // plateau plein
+        }
+
+        // n-ième case libre, n tiré au hasard
+        int rang = (int)(aleatoire(graine) % (uint64_t)n), i = 0;
+        while (rang >= __builtin_popcountll(libres.mots[i])) {
+            rang -= __builtin_popcountll(libres.mots[i++]);
+        }
+        uint64_t m = libres.mots[i];
+        while (rang-- > 0) m &= m - 1;
+        int c = i * 64 + __builtin_ctzll(m);
+
+        if (coup_simule(&pions[j], &pions[1 - j], &prises[j], c)) return j == 0 ? 'X' : 'O';
+        for (int d = 0; d < 8; d++) {
+            int v = c + pas_sens(d);
+            if (v >= 0 && v < NB_CASES_BITS) poser_bit(&zone, v);
+        }
+        j = 1 - j;
+    }
+    return 0;
+}
+
+/*
+ * -------------------------------------------------------
+ * action : simuler
+ * -------------------------------------------------------
+ * But          : Une simulation : descente (perte virtuelle),
+ *                développement, partie au hasard, remontée
+ *                du résultat le long du chemin
+ * -------------------------------------------------------
+ */
+static void simuler(ArbreMCTS *a, uint64_t *graine) {
+    NoeudMCTS *noeuds = a->reserves[a->courante];
+    Plateau p = a->racine;
+    char joueur = a->trait, vainqueur = 0;
+    uint32_t chemin[MCTS_CHEMIN_MAX];
+    int n = 0;
+    bool fini = false;
+
+    uint32_t indice = 0;
+    atomic_fetch_add_explicit(&noeuds[0].visites, 1, memory_order_relaxed);
+    chemin[n++] = 0;
+    while (n < MCTS_CHEMIN_MAX) {
+        NoeudMCTS *noeud = &noeuds[indice];
+        uint8_t etat = atomic_load_explicit(&noeud->etat, memory_order_acquire);
+        if (etat == A_DEVELOPPER && atomic_load_explicit(&noeud->visites, memory_order_relaxed) >= MCTS_SEUIL) {
+            uint8_t attendu = A_DEVELOPPER;
+            if (atomic_compare_exchange_strong(&noeud->etat, &attendu, EN_DEVELOPPEMENT) &&
+                developper(a, indice, &p, joueur)) {
+                etat = DEVELOPPE;
+            }
+        }
+        if (etat != DEVELOPPE || noeud->nb_enfants == 0) break;
+
+        indice = choisir_enfant(noeuds, noeud);
+        atomic_fetch_add_explicit(&noeuds[indice].visites, 1, memory_order_relaxed);
+        chemin[n++] = indice;
+        Annulation an;
+        jouer_coup(&p, noeuds[indice].coup / LARGEUR_LIGNE, noeuds[indice].coup % LARGEUR_LIGNE, joueur, &an);
+        if (noeuds[indice].gagnant) {
+            vainqueur = joueur;
+            fini = true;
+            break;
+        }
+        joueur = (joueur == 'X') ? 'O' : 'X';
+    }
+    if (!fini) vainqueur = jouer_au_hasard(&p, joueur, graine);
+
+    // le noeud de profondeur k a été atteint par un coup de 'trait' si k est impair
+    char adversaire = (a->trait == 'X') ? 'O' : 'X';
+    for (int k = 0; k < n; k++) {
+        char auteur = (k & 1) ? a->trait : adversaire;
+        uint32_t gain = (vainqueur == 0) ? 1 : (vainqueur == auteur) ? 2 : 0;
+        if (gain) atomic_fetch_add_explicit(&noeuds[chemin[k]].gains, gain, memory_order_relaxed);
+    }
+}
+
+/*
+ * -------------------------------------------------------
+ * Fonction: travailleur_mcts
+ * -------------------------------------------------------
+ * But          : Boucle d'un thread : simulations jusqu'à
+ *                l'arrêt ; le thread qui épuise le budget
+ *                arrête les autres
+ * Données      : arg (graine du thread)
+ * -------------------------------------------------------
+ */
+static void *travailleur_mcts(void *arg) {
+    ArbreMCTS *a = &arbre_mcts;
+    uint64_t graine = *(uint64_t *)arg;
+    for (long long local = 1; !atomic_load_explicit(&a->arret, memory_order_relaxed); local++) {
+        simuler(a, &graine);
+        long long total = atomic_fetch_add_explicit(&a->simulations, 1, memory_order_relaxed) + 1;
+        if ((a->budget.noeuds > 0 && total >= a->budget.noeuds) ||
+            (a->budget.temps > 0 && (local & 15) == 0 && horloge() - a->debut >= a->budget.temps)) {
+            atomic_store_explicit(&a->arret, true, memory_order_relaxed);
+        }
+    }
+    return NULL;
+}
+
+/*
+ * -------------------------------------------------------
+ * Fonction: reprendre_arbre
+ * -------------------------------------------------------
+ * But          : Cherche la position de clé 'cle' parmi la
+ *                racine, ses enfants et petits-enfants ; si
+ *                elle y est, recopie son sous-arbre (parcours
+ *                en largeur, enfants toujours contigus) dans
+ *                l'autre réserve, qui devient la courante
+ * Résultat     : true si l'arbre est réutilisé
+ * -------------------------------------------------------
+ */
+static bool reprendre_arbre(ArbreMCTS *a, uint64_t cle) {
+    NoeudMCTS *source = a->reserves[a->courante];
+    if (atomic_load_explicit(&a->utilises, memory_order_relaxed) == 0) return false;
+
+    uint32_t trouve = MCTS_AUCUN;
+    if (source[0].cle == cle) trouve = 0;
+    for (uint32_t k = 0; trouve == MCTS_AUCUN && k < source[0].nb_enfants; k++) {
+        const NoeudMCTS *e = &source[source[0].premier_enfant + k];
+        if (e->cle == cle) trouve = source[0].premier_enfant + k;
+        for (uint32_t m = 0; trouve == MCTS_AUCUN && m < e->nb_enfants; m++) {
+            if (source[e->premier_enfant + m].cle == cle) trouve = e->premier_enfant + m;
+        }
+    }
+    if (trouve == MCTS_AUCUN) return false;
+
+    NoeudMCTS *cible = a->reserves[1 - a->courante];
+    memcpy(&cible[0], &source[trouve], sizeof(NoeudMCTS));
+    uint32_t n = 1;
+    for (uint32_t k = 0; k < n; k++) {
+        if (cible[k].nb_enfants == 0) continue;
+        memcpy(&cible[n], &source[cible[k].premier_enfant], cible[k].nb_enfants * sizeof(NoeudMCTS));
+        cible[k].premier_enfant = n;
+        n += cible[k].nb_enfants;
+    }
+    a->courante = 1 - a->courante;
+    atomic_store_explicit(&a->utilises, n, memory_order_relaxed);
+    return true;
+}
+
+/*
+ * -------------------------------------------------------
+ * Fonction: choisir_coup_mcts
+ * -------------------------------------------------------
+ * Nature       : Fonction
+ * But          : Coup de 'joueur' par MCTS sur 'threads'
+ *                threads jusqu'à épuisement du budget (temps,
+ *                ou nombre de simulations) ; le coup retenu
+ *                est l'enfant de la racine le plus visité
+ * Données      : p (plateau), joueur, budget, threads
+ * Résultats    : ligne, colonne (0..18), simulations faites,
+ *                durée (secondes), taux de gain estimé
+ * Résultat     : false si aucune case n'est libre
+ * -------------------------------------------------------
+ */
+bool choisir_coup_mcts(const Plateau *p, char joueur, const Budget *budget, int threads,
+                       int *ligne, int *colonne, long long *simulations, double *duree, double *taux) {
+    ArbreMCTS *a = &arbre_mcts;
+    a->racine = *p;
+    a->trait = joueur;
+    a->budget = *budget;
+    atomic_store(&a->simulations, 0);
+    atomic_store(&a->arret, false);
+    if (!reprendre_arbre(a, p->cle)) {
+        atomic_store(&a->utilises, 1);
+        preparer_noeud(&a->reserves[a->courante][0], p->cle, -1, false);
+    }
+    NoeudMCTS *noeuds = a->reserves[a->courante];
+    if (atomic_load(&noeuds[0].etat) == A_DEVELOPPER) {
+        Plateau q = *p;
+        atomic_store(&noeuds[0].etat, EN_DEVELOPPEMENT);
+        developper(a, 0, &q, joueur);
+    }
+    if (atomic_load(&noeuds[0].etat) != DEVELOPPE || noeuds[0].nb_enfants == 0) return false;
+
+    a->debut = horloge();
+    pthread_t aides[THREADS_MAX];
+    uint64_t graines[THREADS_MAX];
+    int lances = 0;
+    for (int t = 0; t < threads; t++) {
+        graines[t] = (p->cle ^ (0x9E3779B97F4A7C15u * (uint64_t)(t + 1))) | 1;
+    }
+    for (int t = 1; t < threads; t++) {
+        if (pthread_create(&aides[lances], NULL, travailleur_mcts, &graines[t]) == 0) lances++;
+    }
+    travailleur_mcts(&graines[0]);
+    for (int t = 0; t < lances; t++) {
+        pthread_join(aides[t], NULL);
+    }
+    *duree = horloge() - a->debut;
+
+    const NoeudMCTS *meilleur = &noeuds[noeuds[0].premier_enfant];
+    for (uint32_t k = 1; k < noeuds[0].nb_enfants; k++) {
+        const NoeudMCTS *e = &noeuds[noeuds[0].premier_enfant + k];
+        if (atomic_load(&e->visites) > atomic_load(&meilleur->visites)) meilleur = e;
+    }
+    uint32_t v = atomic_load(&meilleur->visites);
+    *taux = v ? atomic_load(&meilleur->gains) / (2.0 * v) : 0.5;
+    *ligne = meilleur->coup / LARGEUR_LIGNE;
+    *colonne = meilleur->coup % LARGEUR_LIGNE;
+    *simulations = atomic_load(&a->simulations);
+    return true;
+}
+
+/*
+ * Structure : ReglagesIA
+ * ----------------------
+ *  - Rôle : réglages d'un joueur confié à l'IA
+ *  - Attributs :
+ *      moteur  : MOTEUR_ALPHABETA (choisir_coup) ou MOTEUR_MCTS
+ *                (choisir_coup_mcts)
+ *      budget  : limites par coup
+ *      threads : threads de recherche (1..THREADS_MAX)
+ */
+typedef enum { MOTEUR_ALPHABETA, MOTEUR_MCTS } Moteur;
+
+typedef struct {
+    Moteur moteur;
+    Budget budget;
+    int threads;
+} ReglagesIA;
+
+
+/*
+ * -------------------------------------------------------
+ * Fonction: resultat_coup
+ * -------------------------------------------------------
+ * But          : Après la pose du pion (ligne, colonne) de
+ *                'joueur' : effectue les prises, puis
+ *                détecte la victoire
+ * Résultat     : 1 si le joueur a gagné (alignement ou 10
+ *                prises), 0 sinon
+ * -------------------------------------------------------
+ */
+int resultat_coup(Plateau *plateau, int ligne, int colonne, char joueur) {
+    // Vérifier si on capture des pions
+    verifier_prise(plateau, ligne, colonne, joueur);
+
+    // Vérifier alignement >= 5
+    if (verifier_alignement(plateau, ligne, colonne, joueur)) {
+        return 1; // alignement => victoire
+    }
+
+    // Vérifier victoire par 10 prises
+    if (plateau->prises_joueur_X >= 10) {
+        if (joueur == 'X') {
+            return 1; // X gagne
+        }
+    }
+    if (plateau->prises_joueur_O >= 10) {
+        if (joueur == 'O') {
+            return 1; // O gagne
+        }
+    }
+
+    return 0; // pas de victoire ni d'abandon => la partie continue
+}
+
+
+/**
+ * -------------------------------------------------------
+ *  Fonction : tour_de_jeu
+ * -------------------------------------------------------
+ *  Rôle :
+ *    - Demander au joueur en cours de saisir un coup,
+ *      ou le faire choisir par choisir_coup (ou choisir_coup_mcts)
+ *      s'il est joué par l'IA
+ *    - Gérer l'abandon si (0,0)
+ *    - Placer le pion si possible
+ *    - Vérifier les prises et l’alignement
+ *  donnés :
+ *    - plateau : pointeur vers la structure du plateau
+ *    - joueur  : chaine de caractère représentant le joueur ('O' ou 'X')
+ *    - ia      : réglages de l'IA si le joueur est l'IA, NULL sinon
+ *  Variables Locales :
+ *    - ligne,colonne: entier représentant les lignes et les colennes du plateau
+ *    - ch: entier pour vider le buffer
+ *  resultat :
+ *    -  0 si le coup est normal et la partie continue
+ *    -  1 si le joueur a gagné (par alignement ou par 10 prises)
+ *    - -1 si le joueur abandonne
+ * -------------------------------------------------------
+ */
+int tour_de_jeu(Plateau *plateau, char joueur, const ReglagesIA *ia) {
+    // Affiche l’état actuel (on peut le faire ici ou dans main)
+    afficher_plateau(plateau);
+    int ligne, colonne;
+
+    if (ia && ia->moteur == MOTEUR_MCTS) {
+        long long simulations;
+        double duree, taux;
+        if (!choisir_coup_mcts(plateau, joueur, &ia->budget, ia->threads, &ligne, &colonne,
+                               &simulations, &duree, &taux)) {
+            return 0;
+        }
+        printf("Joueur %c (MCTS) joue %d,%d (%lld simulations, %.0f simulations/s, %d threads, gain estimé %.0f%%)\n",
+               joueur, ligne + 1, colonne + 1, simulations, duree > 0 ? simulations / duree : 0.0,
+               ia->threads, 100.0 * taux);
+        placer_pion(plateau, ligne, colonne, joueur);
+        return resultat_coup(plateau, ligne, colonne, joueur);
+    }
+    if (ia) {
+        // Coup de l'IA, déjà en indices (0..18)
+        int profondeur;
+        long long noeuds;
+        if (!choisir_coup(plateau, joueur, &ia->budget, ia->threads, &ligne, &colonne, &profondeur, &noeuds)) {
+            return 0;
+        }
+        printf("Joueur %c (IA) joue %d,%d (profondeur %d, %lld noeuds)\n",
+               joueur, ligne + 1, colonne + 1, profondeur, noeuds);
+        placer_pion(plateau, ligne, colonne, joueur);
+        return resultat_coup(plateau, ligne, colonne, joueur);
+    }
+
+    // Demander le coup
+    printf("Joueur %c, entrez votre coup (ligne,colonne) [0,0 pour abandon] : ", joueur);
+
+    // Vérifier la validité du format
+    if (scanf("%d,%d", &ligne, &colonne) != 2) {
+        // Mauvais format => on ignore ce tour et on retourne 0 (continuer)
+        printf("Format invalide! (ex: 5,10)\n");
+        // Vider le buffer
+        // si on ne vide pas le buffer dans le cas d'une mauvaise saisie 5,99 et d'un correction par la suite en 5,9 le code prendra 5,5
+        int ch;
+        while ((ch = getchar()) != '\n' && ch != EOF) {}
+        return 0;
+    }
+
+    // Abandon
+    if (ligne == 0 && colonne == 0) {
+        return -1; // signal d'abandon
+    }
+
+    // Conversion indices (1..19) -> (0..18)
+    ligne   -= 1;
+    colonne -= 1;
+
+    // Placer le pion si possible
+    if (!placer_pion(plateau, ligne, colonne, joueur)) {
+        printf("Coup invalide (hors-limites ou case non vide). Réessayez.\n");
+        return 0;
+    }
+
+    return resultat_coup(plateau, ligne, colonne, joueur);
+}
+
+
+/*******************************************************
+ *  Banc d'essai Lazy SMP : temps jusqu'à une profondeur
+ *******************************************************/
+#define BANC_COUPS_MAX 1024
+
+/*
+ * -------------------------------------------------------
+ * Fonction: charger_position
+ * -------------------------------------------------------
+ * Nature       : Fonction
+ * But          : Position de milieu de partie tirée d'un
+ *                fichier de partie (un coup "ligne,colonne"
+ *                par ligne, comme au clavier) : les coups sont
+ *                rejoués comme par tour_de_jeu (O commence,
+ *                coup invalide ignoré, 0,0 arrête) sur la
+ *                première moitié de la partie, 40 coups au
+ *                plus ; un coup gagnant arrête la relecture
+ *                avant d'être joué
+ * Données      : chemin (fichier)
+ * Résultats    : p (plateau), joueur (joueur au trait),
+ *                joues (coups rejoués)
+ * Résultat     : false si le fichier est illisible
+ * -------------------------------------------------------
+ */
+static bool charger_position(const char *chemin, Plateau *p, char *joueur, int *joues) {
+    FILE *f = fopen(chemin, "r");
+    if (!f) return false;
+    static int lignes[BANC_COUPS_MAX], colonnes[BANC_COUPS_MAX];
+    int n = 0, ch;
+    while (n < BANC_COUPS_MAX) {
+        int r = fscanf(f, "%d,%d", &lignes[n], &colonnes[n]);
+        if (r == EOF) break;
+        if (r == 2) n++;
+        while ((ch = fgetc(f)) != '\n' && ch != EOF) {}
+    }
+    fclose(f);
+
+    int cible = (n / 2 < 40) ? n / 2 : 40;
+    initialiser_plateau(p);
+    *joueur = 'O';
+    *joues = 0;
+    for (int k = 0; k < cible && !(lignes[k] == 0 && colonnes[k] == 0); k++) {
+        Plateau q = *p;
+        if (!placer_pion(&q, lignes[k] - 1, colonnes[k] - 1, *joueur)) continue;
+        if (resultat_coup(&q, lignes[k] - 1, colonnes[k] - 1, *joueur) == 1 || est_plein(&q)) break;
+        *p = q;
+        *joueur = (*joueur == 'X') ? 'O' : 'X';
+        (*joues)++;
+    }
+    return true;
+}
+
+/*
+ * -------------------------------------------------------
+ * Fonction: lancer_banc
+ * -------------------------------------------------------
+ * Nature       : Fonction
+ * But          : Pour chaque position (charger_position) et
+ *                pour 1, 2, 4, ... jusqu'à 'threads' threads,
+ *                mesure le temps de choisir_coup jusqu'à
+ *                'profondeur', table de transposition vidée
+ *                avant chaque mesure ; écrit un CSV
+ *                position,threads,profondeur,temps_s,noeuds,acceleration
+ *                puis le total par nombre de threads
+ * Données      : fichiers, nb (nombre de fichiers),
+ *                profondeur, threads
+ * Résultat     : EXIT_SUCCESS, EXIT_FAILURE si un fichier
+ *                est illisible
+ * -------------------------------------------------------
+ */
+static int lancer_banc(char **fichiers, int nb, int profondeur, int threads) {
+    int paliers[THREADS_MAX], nb_paliers = 0;
+    for (int t = 1; t < threads; t *= 2) paliers[nb_paliers++] = t;
+    paliers[nb_paliers++] = threads;
+    double totaux[THREADS_MAX] = { 0 };
+    Budget budget = { .temps = 0, .noeuds = 0, .profondeur = profondeur };
+
+    printf("position,threads,profondeur,temps_s,noeuds,acceleration\n");
+    for (int f = 0; f < nb; f++) {
+        Plateau p;
+        char joueur;
+        int joues;
+        if (!charger_position(fichiers[f], &p, &joueur, &joues)) {
+            fprintf(stderr, "Impossible de lire %s\n", fichiers[f]);
+            return EXIT_FAILURE;
+        }
+        double reference = 0;
+        for (int k = 0; k < nb_paliers; k++) {
+            vider_table();
+            int ligne, colonne, atteinte;
+            long long noeuds;
+            double debut = horloge();
+            if (!choisir_coup(&p, joueur, &budget, paliers[k], &ligne, &colonne, &atteinte, &noeuds)) break;
+            double temps = horloge() - debut;
+            if (k == 0) reference = temps;
+            totaux[k] += temps;
+            printf("%s@%d,%d,%d,%.4f,%lld,%.2f\n", fichiers[f], joues, paliers[k], atteinte, temps, noeuds,
+                   temps > 0 ? reference / temps : 0.0);
+        }
+    }
+    for (int k = 0; k < nb_paliers; k++) {
+        printf("total,%d,%d,%.4f,,%.2f\n", paliers[k], profondeur, totaux[k],
+               totaux[k] > 0 ? totaux[0] / totaux[k] : 0.0);
+    }
+    return EXIT_SUCCESS;
+}
+
+
+#if defined(TEST) && TEST == 3
+/*******************************************************
+ *  Test des coups réversibles (make test_case3)
+ *******************************************************/
+
+/*
+ * -------------------------------------------------------
+ * Fonction: memes_plateaux
+ * -------------------------------------------------------
+ * But          : Vrai si a et b ont les mêmes pions, les
+ *                mêmes prises, la même clé, les mêmes codes
+ *                de lignes et la même évaluation
+ * -------------------------------------------------------
+ */
+static bool memes_plateaux(const Plateau *a, const Plateau *b) {
+    for (int i = 0; i < NB_MOTS; i++) {
+        if (a->pions_X.mots[i] != b->pions_X.mots[i] || a->pions_O.mots[i] != b->pions_O.mots[i]) {
+            return false;
+        }
+    }
+    return a->prises_joueur_X == b->prises_joueur_X && a->prises_joueur_O == b->prises_joueur_O &&
+           a->cle == b->cle && a->evaluation == b->evaluation &&
+           memcmp(a->lignes, b->lignes, sizeof a->lignes) == 0;
+}
+
+/*
+ * -------------------------------------------------------
+ * Fonction: evaluation_complete
+ * -------------------------------------------------------
+ * But          : Valeur des motifs recalculée de zéro en
+ *                parcourant toutes les fenêtres de 4 et de 5
+ *                cases du plateau (sans les tables de lignes),
+ *                pour contrôler l'évaluation tenue à jour
+ * -------------------------------------------------------
+ */
+static int32_t evaluation_complete(const Plateau *p) {
+    static const int dl[4] = { 0, 1, 1, 1 }, dc[4] = { 1, 0, 1, -1 };
+    int32_t total = 0;
+    for (int d = 0; d < 4; d++) {
+        for (int ligne = 0; ligne < TAILLE_PLATEAU; ligne++) {
+            for (int colonne = 0; colonne < TAILLE_PLATEAU; colonne++) {
+                uint32_t x = 0, o = 0;
+                for (int k = 0; k < 5; k++) {
+                    int l = ligne + k * dl[d], c = colonne + k * dc[d];
+                    if (!position_valide(l, c)) break;
+                    x |= (uint32_t)tester_bit(&p->pions_X, bit_case(l, c)) << k;
+                    o |= (uint32_t)tester_bit(&p->pions_O, bit_case(l, c)) << k;
+                    if (k == 3) total += MOTIFS_4[x | o << 4];
+                    if (k == 4) total += MOTIFS_5[x | o << 5];
+                }
+            }
+        }
+    }
+    return total;
+}
+
+/*
+ * -------------------------------------------------------
+ * Fonction: cle_complete
+ * -------------------------------------------------------
+ * But          : Clé de Zobrist recalculée de zéro, pour
+ *                contrôler la clé tenue à jour
+ * -------------------------------------------------------
+ */
+static uint64_t cle_complete(const Plateau *p, char trait) {
+    uint64_t cle = zobrist_prises(0, p->prises_joueur_X) ^ zobrist_prises(1, p->prises_joueur_O);
+    if (trait == 'X') cle ^= ZOBRIST_TRAIT;
+    for (int i = 0; i < NB_CASES_BITS; i++) {
+        if (tester_bit(&p->pions_X, i)) cle ^= ZOBRIST_PIONS[0][i];
+        if (tester_bit(&p->pions_O, i)) cle ^= ZOBRIST_PIONS[1][i];
+    }
+    return cle;
+}
+
+/*
+ * -------------------------------------------------------
+ * Fonction: tester_coups
+ * -------------------------------------------------------
+ * But          : Parties aléatoires (graine fixe) jouées
+ *                avec jouer_coup, dans une zone réduite
+ *                pour provoquer des prises ; à chaque coup :
+ *                  - même plateau et même résultat que
+ *                    placer_pion + resultat_coup sur une copie
+ *                  - clé et évaluation égales à celles
+ *                    recalculées de zéro
+ *                de temps en temps, quelques coups sont
+ *                défaits par annuler_coup et chaque plateau
+ *                retrouvé est comparé à celui d'avant le coup ;
+ *                en fin de partie tout est défait jusqu'au
+ *                plateau vide
+ * Résultat     : true si aucune différence n'est trouvée
+ * -------------------------------------------------------
+ */
+static bool tester_coups(void) {
+    enum { NB_PARTIES = 2000, COUPS_MAX = 300 };
+    static Plateau avant[COUPS_MAX];
+    static Annulation annulations[COUPS_MAX];
+    long coups = 0, defaits = 0, prises_vues = 0, erreurs = 0;
+    srand(12345);
+
+    for (int partie = 0; partie < NB_PARTIES; partie++) {
+        Plateau p, vide;
+        initialiser_plateau(&p);
+        vide = p;
+        int zone = 5 + rand() % (TAILLE_PLATEAU - 4);
+        int n = 0, essais = 0;
+        char joueur = 'O';
+        bool fini = false;
+        while (!fini && n < COUPS_MAX && essais++ < 20 * COUPS_MAX) {
+            int ligne = rand() % zone, colonne = rand() % zone;
+            Plateau reference = p;
+            avant[n] = p;
+            int resultat = jouer_coup(&p, ligne, colonne, joueur, &annulations[n]);
+            if (resultat < 0) {
+                // case occupée : rien ne doit avoir changé
+                erreurs += !memes_plateaux(&p, &reference);
+                continue;
+            }
+            placer_pion(&reference, ligne, colonne, joueur);
+            int attendu = resultat_coup(&reference, ligne, colonne, joueur);
+            char suivant = (joueur == 'X') ? 'O' : 'X';
+            if (resultat != attendu || !memes_plateaux(&p, &reference) || p.cle != cle_complete(&p, suivant) ||
+                p.evaluation != evaluation_complete(&p)) {
+                erreurs++;
+            }
+            prises_vues += annulations[n].sens != 0;
+            coups++;
+            n++;
+            fini = (resultat == 1);
+            joueur = suivant;
+
+            // retour en arrière de 1 à 4 coups, une fois sur huit
+            if (!fini && rand() % 8 == 0) {
+                for (int k = 1 + rand() % 4; k > 0 && n > 0; k--) {
+                    n--;
+                    annuler_coup(&p, &annulations[n]);
+                    erreurs += !memes_plateaux(&p, &avant[n]);
+                    joueur = annulations[n].joueur;
+                    defaits++;
+                }
+            }
+        }
+        while (n > 0) {
+            n--;
+            annuler_coup(&p, &annulations[n]);
+            erreurs += !memes_plateaux(&p, &avant[n]);
+            defaits++;
+        }
+        erreurs += !memes_plateaux(&p, &vide);
+    }
+
+    printf("test_case3 : %d parties, %ld coups joués, %ld défaits, %ld coups avec prise : %ld erreur(s)\n",
+           NB_PARTIES, coups, defaits, prises_vues, erreurs);
+    return erreurs == 0;
+}
+#endif
+
+
+/**
+ * -------------------------------------------------------
+ *  Fonction principale : main
+ * -------------------------------------------------------
+ *  Rôle :
+ *    - Créer et initialiser le plateau
+ *    - Lire les options :
+ *        --ai=X|O|both : joueur(s) confié(s) à l'IA
+ *        --temps=MS    : budget de l'IA par coup en millisecondes
+ *                        (1000 par défaut, 0 : illimité)
+ *        --noeuds=N    : budget de l'IA par coup en positions
+ *                        (simulations pour MCTS ; 0 par défaut :
+ *                        illimité)
+ *        --moteur=M    : alphabeta (par défaut) ou mcts
+ *        --threads=N   : threads de recherche (1 par défaut ; pour
+ *                        alphabeta, threads auxiliaires de Lazy SMP)
+ *        --profondeur=D: profondeur maximale d'alphabeta (0 : illimitée)
+ *        --banc FICHIER... : pas de partie, temps jusqu'à la
+ *                        profondeur D (5 par défaut) de 1 à N threads
+ *                        sur des positions tirées des fichiers de partie
+ *    - Déterminer qui commence ('O')
+ *    - Gérer la boucle de jeu (appels successifs à tour_de_jeu)
+ *    - Annoncer le vainqueur ou l'abandon
+ * -------------------------------------------------------
+ */
+int main(int argc, char **argv) {
+#if defined(TEST) && TEST == 3
+    (void)argc;
+    (void)argv;
+    return tester_coups() ? EXIT_SUCCESS : EXIT_FAILURE;
+#endif
+    ReglagesIA reglages = { .moteur = MOTEUR_ALPHABETA, .budget = { .temps = 1.0, .noeuds = 0 }, .threads = 1 };
+    Budget *budget = &reglages.budget;
+    bool ia_X = false, ia_O = false, banc = false;
+    char *fichiers[64];
+    int nb_fichiers = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--ai=X") == 0) ia_X = true;
+        else if (strcmp(argv[i], "--ai=O") == 0) ia_O = true;
+        else if (strcmp(argv[i], "--ai=both") == 0) ia_X = ia_O = true;
+        else if (strncmp(argv[i], "--temps=", 8) == 0) budget->temps = atof(argv[i] + 8) / 1000.0;
+        else if (strncmp(argv[i], "--noeuds=", 9) == 0) budget->noeuds = atoll(argv[i] + 9);
+        else if (strcmp(argv[i], "--moteur=alphabeta") == 0) reglages.moteur = MOTEUR_ALPHABETA;
+        else if (strcmp(argv[i], "--moteur=mcts") == 0) reglages.moteur = MOTEUR_MCTS;
+        else if (strncmp(argv[i], "--threads=", 10) == 0) reglages.threads = atoi(argv[i] + 10);
+        else if (strncmp(argv[i], "--profondeur=", 13) == 0) budget->profondeur = atoi(argv[i] + 13);
+        else if (strcmp(argv[i], "--banc") == 0) banc = true;
+        else if (argv[i][0] != '-' && nb_fichiers < 64) fichiers[nb_fichiers++] = argv[i];
+        else {
+            fprintf(stderr, "Usage : %s [--ai=X|O|both] [--temps=MS] [--noeuds=N] [--moteur=alphabeta|mcts] [--threads=N]\n"
+                            "              [--profondeur=D] [--banc FICHIER...]\n",
+                    argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (budget->temps < 0 || budget->noeuds < 0 || budget->profondeur < 0) {
+        fprintf(stderr, "Budget de l'IA invalide\n");
+        return EXIT_FAILURE;
+    }
+    if (reglages.threads < 1 || reglages.threads > THREADS_MAX) {
+        fprintf(stderr, "Nombre de threads invalide (1 à %d)\n", THREADS_MAX);
+        return EXIT_FAILURE;
+    }
+    if (reglages.moteur == MOTEUR_MCTS && budget->temps == 0 && budget->noeuds == 0) {
+        fprintf(stderr, "MCTS demande un budget (--temps ou --noeuds)\n");
+        return EXIT_FAILURE;
+    }
+
+    if (nb_fichiers > 0 && !banc) {
+        fprintf(stderr, "Les fichiers de partie ne servent qu'avec --banc\n");
+        return EXIT_FAILURE;
+    }
+    if (banc) {
+        if (!initialiser_table()) {
+            fprintf(stderr, "Mémoire insuffisante pour la table de transposition\n");
+            return EXIT_FAILURE;
+        }
+        return lancer_banc(fichiers, nb_fichiers, budget->profondeur > 0 ? budget->profondeur : 5, reglages.threads);
+    }
+
+    if ((ia_X || ia_O) && reglages.moteur == MOTEUR_ALPHABETA && !initialiser_table()) {
+        fprintf(stderr, "Mémoire insuffisante pour la table de transposition : l'IA jouera sans\n");
+    }
+    if ((ia_X || ia_O) && reglages.moteur == MOTEUR_MCTS && !initialiser_mcts()) {
+        fprintf(stderr, "Mémoire insuffisante pour l'arbre de MCTS\n");
+        return EXIT_FAILURE;
+    }
+
     Plateau plateau;
     initialiser_plateau(&plateau);
 
@@ -407,7 +2250,8 @@ int main() {
 
     // Boucle de jeu
     while (!partieFinie) {
-        int resultat = tour_de_jeu(&plateau, joueur);
+        bool ia = (joueur == 'X') ? ia_X : ia_O;
+        int resultat = tour_de_jeu(&plateau, joueur, ia ? &reglages : NULL);
 
         if (resultat == -1) {
             // Abandon
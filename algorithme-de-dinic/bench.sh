@@ -0,0 +1,79 @@
+#!/bin/sh
+# -----------------------------------------------------------------------------
+# Banc d'essai : moteurs de flot sur les familles de réseaux de generateur
+#
+# UTILISATION : ./bench.sh [-a "algo..."] [-f "famille..."] [-g graine]
+#   - génère chaque famille (rmf, grille, ak, biparti, large, segmentation,
+#     volume) sur une gamme de tailles croissantes, avec une graine fixe (1 par
+#     défaut)
+#   - exécute dinic avec chaque algorithme (par défaut : dinic scaling hipr
+#     parallel bk) ; segmentation et volume sont des grilles implicites,
+#     résolues par dinic --grille (algo bk-grille, sommets = voxels)
+#   - écrit sur la sortie standard un CSV :
+#     famille,taille,sommets,arcs,algo,temps_s,rss_ko,flot
+#     (temps écoulé et pic de mémoire résidente mesurés par ./mesure)
+#   - signale sur la sortie d'erreur les réseaux où les algorithmes divergent
+# -----------------------------------------------------------------------------
+set -e
+
+DINIC=$(realpath "${DINIC:-./dinic}")
+GENERATEUR=$(realpath "${GENERATEUR:-./generateur}")
+MESURE=$(realpath "${MESURE:-./mesure}")
+ALGOS="dinic scaling hipr parallel bk"
+FAMILLES="rmf grille ak biparti large segmentation volume"
+GRAINE=1
+while getopts "a:f:g:" opt; do
+    case $opt in
+        a) ALGOS=$OPTARG ;;
+        f) FAMILLES=$OPTARG ;;
+        g) GRAINE=$OPTARG ;;
+        *) echo "Usage : $0 [-a \"algo...\"] [-f \"famille...\"] [-g graine]" >&2; exit 1 ;;
+    esac
+done
+
+# gamme de tailles de chaque famille (paramètre taille de generateur)
+tailles() {
+    case $1 in
+        rmf)     echo "8 16 24" ;;
+        grille)  echo "50 100 200" ;;
+        ak)      echo "1000 2000 4000" ;;
+        biparti) echo "10000 40000 160000" ;;
+        large)   echo "10000 40000 160000" ;;
+        segmentation) echo "250 500 1000" ;;
+        volume)  echo "25 50 80" ;;
+    esac
+}
+
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+echo "famille,taille,sommets,arcs,algo,temps_s,rss_ko,flot"
+for famille in $FAMILLES; do
+    for taille in $(tailles "$famille"); do
+        reseau="$TMP/$famille-$taille.max"
+        "$GENERATEUR" "$famille" "$taille" "$GRAINE" > "$reseau"
+        case $famille in
+            segmentation|volume)
+                dims=$(awk '/^p grille/ { n = $3 * $4 * $5; print n "," n * $6; exit }' "$reseau")
+                algos="bk-grille" ;;
+            *)
+                dims=$(sed -n 's/^p max \([0-9]*\) \([0-9]*\).*/\1,\2/p' "$reseau")
+                algos=$ALGOS ;;
+        esac
+        ref=""
+        for algo in $algos; do
+            if [ "$algo" = bk-grille ]; then
+                mesure=$(cd "$TMP" && "$MESURE" "$DINIC" --grille "$reseau")
+            else
+                mesure=$(cd "$TMP" && "$MESURE" "$DINIC" --algo="$algo" "$reseau")
+            fi
+            flot=$(sed -n 's/^Flot maximal : //p' "$TMP/resultat.txt")
+            echo "$famille,$taille,$dims,$algo,$mesure,$flot"
+            [ -z "$ref" ] && ref=$flot
+            if [ "$flot" != "$ref" ]; then
+                echo "Attention : $famille-$taille : $algo donne $flot au lieu de $ref" >&2
+            fi
+        done
+        rm -f "$reseau"
+    done
+done
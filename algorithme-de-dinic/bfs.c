@@ -0,0 +1,331 @@
+#define _DEFAULT_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "dinic_interne.h"
+
+// -----------------------------------------------------------------------------
+// Graphe de niveaux par BFS parallèle à direction optimisée (Beamer et al.)
+//
+// Le BFS avance niveau par niveau ; la frontière du niveau L occupe
+// file[debutNiveau, finNiveau) et le niveau L+1 est ajouté à sa suite.
+// - sens descendant : chaque sommet de la frontière parcourt ses arcs sortants
+//   de capacité >= delta et réclame les sommets non visités par un OU atomique
+//   sur le bitmap 'visite' ;
+// - sens montant    : chaque sommet non visité v parcourt ses arcs e (v->w) et
+//   s'arrête au premier w de la frontière (bitmap 'frontiere') dont l'arc
+//   inverse w->v a une capacité >= delta. Les sommets sont distribués par mots
+//   de 64 : un seul thread écrit chaque mot de 'visite', sans atomique.
+// Le sens est choisi avant chaque niveau : montant quand la frontière grandit
+// et dépasse 1/BFS_ALPHA des sommets non visités, retour au sens descendant
+// quand elle décroît sous n/BFS_BETA sommets. Les tailles sont comptées en
+// sommets et non en arcs (degré moyen supposé) : sommer les degrés coûterait
+// un accès aléatoire à debut par sommet découvert. BFS_ALPHA est bien plus
+// petit que pour un graphe social : dans un graphe résiduel, une grande part
+// des sommets non visités est inaccessible et le sens montant les parcourt
+// en entier à chaque niveau.
+// Les niveaux obtenus sont exactement ceux de buildLevelGraph (seul l'ordre
+// des sommets dans la file dépend des threads) et le BFS s'arrête après le
+// niveau du puits.
+// -----------------------------------------------------------------------------
+#define BFS_ALPHA           2
+#define BFS_BETA            24
+#define BFS_BLOC            64          // sommets de la frontière distribués à la fois (descendant)
+#define BFS_MOTS            8           // mots de 64 sommets distribués à la fois (montant)
+#define BFS_TAMPON          256         // sommets accumulés par un thread avant ajout à la file
+#define BFS_MAX_THREADS     64
+#define BFS_SEUIL_PARALLELE (1 << 16)   // en dessous (arcs résiduels), un seul thread
+#define BFS_NIVEAU_PARALLELE 1024       // en dessous (sommets de la frontière), niveau traité par le thread 0
+
+typedef struct {
+    const Graphe *rg;
+    Capacite  delta;
+    const uint64_t *libres;         // si non nul, arcs utilisables = bits à 1 (flotUnitaire), delta ignoré
+    int      *niveau, *file;
+    uint64_t *visite, *frontiere;   // bitmaps de n bits
+    int       nbMots;
+    int       nbThreads;
+    int       niveauCourant;
+    int       debutNiveau, finNiveau;
+    int       tailleAvant;          // taille de la frontière précédente
+    int       queue;                // atomique : fin de la file
+    int       prochain;             // atomique : prochain bloc à distribuer
+    bool      montant, fini;
+    bool      seul;                 // niveau traité par le thread 0 seul : pas d'atomique
+    pthread_barrier_t barriere;
+    pthread_mutex_t verrouDepart;   // porte de départ des threads
+    pthread_cond_t  depart;
+    bool      partez;
+} BfsParallele;
+
+typedef struct {
+    BfsParallele *b;
+    int     id;
+    int64_t arcs;                   // arcs examinés par le thread
+    int     nb;
+    int     tampon[BFS_TAMPON];
+} TravailleurBfs;
+
+static bool estMarque(const uint64_t *bits, int v) {
+    return (__atomic_load_n(&bits[v >> 6], __ATOMIC_RELAXED) >> (v & 63)) & 1;
+}
+
+// arc e utilisable pour le BFS : bit à 1 dans libres, sinon capacité >= delta
+static inline bool arcUtilisable(const uint64_t *libres, const Capacite *capa, Capacite delta, int e) {
+    return libres ? (libres[e >> 6] >> (e & 63)) & 1 : capa[e] >= delta;
+}
+
+// vrai si l'appelant est le premier à marquer v
+static bool reclamer(uint64_t *bits, int v) {
+    uint64_t masque = (uint64_t)1 << (v & 63);
+    return !(__atomic_fetch_or(&bits[v >> 6], masque, __ATOMIC_RELAXED) & masque);
+}
+
+static void bfsVider(TravailleurBfs *t) {
+    int i = __atomic_fetch_add(&t->b->queue, t->nb, __ATOMIC_RELAXED);
+    memcpy(t->b->file + i, t->tampon, (size_t)t->nb * sizeof *t->tampon);
+    t->nb = 0;
+}
+
+static void bfsAjouter(TravailleurBfs *t, int v) {
+    if (t->nb == BFS_TAMPON) bfsVider(t);
+    t->tampon[t->nb++] = v;
+}
+
+
+
+/***********************************************************************************************************/
+/* Action bfsPreparer :                                                                                    */
+/*   - exécutée par le thread 0 entre deux niveaux : le niveau qui vient d'être construit devient la       */
+/*     frontière, puis choix du sens (et bitmap de la frontière en sens montant) ou fin du BFS             */
+/*   - un petit niveau descendant est laissé au thread 0 seul : sur un réseau de grand diamètre, la        */
+/*     plupart des niveaux ne coûtent ainsi ni barrière ni opération atomique                              */
+/***********************************************************************************************************/
+static void bfsPreparer(BfsParallele *b) {
+    const Graphe *rg = b->rg;
+    b->debutNiveau = b->finNiveau;
+    b->finNiveau = b->queue;
+    b->niveauCourant++;
+    int taille = b->finNiveau - b->debutNiveau;
+    if (taille == 0 || estMarque(b->visite, rg->puits)) {
+        b->fini = true;
+        return;
+    }
+    bool croissante = taille > b->tailleAvant;
+    b->tailleAvant = taille;
+    int nonVisites = rg->nbSommets - b->queue;
+    if (!b->montant && croissante && taille > nonVisites / BFS_ALPHA) b->montant = true;
+    else if (b->montant && !croissante && taille < rg->nbSommets / BFS_BETA) b->montant = false;
+    b->seul = b->nbThreads == 1 || (!b->montant && taille < BFS_NIVEAU_PARALLELE);
+    b->prochain = 0;
+    if (b->montant) {
+        memset(b->frontiere, 0, (size_t)b->nbMots * sizeof *b->frontiere);
+        for (int i = b->debutNiveau; i < b->finNiveau; i++) {
+            int u = b->file[i];
+            b->frontiere[u >> 6] |= (uint64_t)1 << (u & 63);
+        }
+    }
+}
+
+// Les champs utiles sont copiés dans des variables locales : les écritures dans niveau et visite
+// empêcheraient sinon le compilateur de les garder en registre.
+
+// niveau descendant traité par le thread 0 seul : niveau sert d'ensemble visité (visite est tenu à
+// jour pour les niveaux suivants) et la file est écrite directement, comme dans buildLevelGraph
+static void bfsDescendantSeul(TravailleurBfs *t) {
+    BfsParallele *b = t->b;
+    const int *debut = b->rg->debut, *dest = b->rg->SommetDest;
+    const Capacite *capa = b->rg->capa, delta = b->delta;
+    const uint64_t *libresArcs = b->libres;
+    uint64_t *visite = b->visite;
+    int *niveau = b->niveau, *file = b->file;
+    const int suivant = b->niveauCourant + 1, finNiveau = b->finNiveau;
+    int queue = b->queue;
+    int64_t arcs = 0;
+    for (int i = b->debutNiveau; i < finNiveau; i++) {
+        int u = file[i];
+        int e = debut[u], finArcs = debut[u + 1];
+        arcs += finArcs - e;
+        for (; e < finArcs; e++) {
+            int v = dest[e];
+            if (niveau[v] < 0 && arcUtilisable(libresArcs, capa, delta, e)) {
+                niveau[v] = suivant;
+                visite[v >> 6] |= (uint64_t)1 << (v & 63);
+                file[queue++] = v;
+            }
+        }
+    }
+    b->queue = queue;
+    t->arcs += arcs;
+}
+
+static void bfsDescendant(TravailleurBfs *t) {
+    BfsParallele *b = t->b;
+    const int *debut = b->rg->debut, *dest = b->rg->SommetDest, *file = b->file;
+    const Capacite *capa = b->rg->capa, delta = b->delta;
+    const uint64_t *libresArcs = b->libres;
+    uint64_t *visite = b->visite;
+    int *niveau = b->niveau;
+    const int suivant = b->niveauCourant + 1, debutNiveau = b->debutNiveau, finNiveau = b->finNiveau;
+    int64_t arcs = 0;
+    for (;;) {
+        int i = debutNiveau + __atomic_fetch_add(&b->prochain, BFS_BLOC, __ATOMIC_RELAXED);
+        if (i >= finNiveau) break;
+        int fin = (i + BFS_BLOC < finNiveau) ? i + BFS_BLOC : finNiveau;
+        for (; i < fin; i++) {
+            int u = file[i];
+            int e = debut[u], finArcs = debut[u + 1];
+            arcs += finArcs - e;
+            for (; e < finArcs; e++) {
+                int v = dest[e];
+                if (!estMarque(visite, v) && arcUtilisable(libresArcs, capa, delta, e) && reclamer(visite, v)) {
+                    niveau[v] = suivant;
+                    bfsAjouter(t, v);
+                }
+            }
+        }
+    }
+    t->arcs += arcs;
+}
+
+static void bfsMontant(TravailleurBfs *t) {
+    BfsParallele *b = t->b;
+    const int *debut = b->rg->debut, *dest = b->rg->SommetDest, *inverse = b->rg->inverse;
+    const Capacite *capa = b->rg->capa, delta = b->delta;
+    const uint64_t *libresArcs = b->libres;
+    const uint64_t *frontiere = b->frontiere;
+    uint64_t *visite = b->visite;
+    int *niveau = b->niveau;
+    const int suivant = b->niveauCourant + 1, nbMots = b->nbMots, reste = b->rg->nbSommets & 63;
+    int64_t arcs = 0;
+    for (;;) {
+        int m = __atomic_fetch_add(&b->prochain, BFS_MOTS, __ATOMIC_RELAXED);
+        if (m >= nbMots) break;
+        int fin = (m + BFS_MOTS < nbMots) ? m + BFS_MOTS : nbMots;
+        for (; m < fin; m++) {
+            uint64_t libres = ~visite[m], trouves = 0;
+            if (m == nbMots - 1 && reste) libres &= ((uint64_t)1 << reste) - 1;
+            while (libres) {
+                int bit = __builtin_ctzll(libres);
+                libres &= libres - 1;
+                int v = (m << 6) | bit;
+                for (int e = debut[v], finArcs = debut[v + 1]; e < finArcs; e++) {
+                    arcs++;
+                    if (estMarque(frontiere, dest[e]) && arcUtilisable(libresArcs, capa, delta, inverse[e])) {
+                        niveau[v] = suivant;
+                        trouves |= (uint64_t)1 << bit;
+                        bfsAjouter(t, v);
+                        break;
+                    }
+                }
+            }
+            visite[m] |= trouves;
+        }
+    }
+    t->arcs += arcs;
+}
+
+// part du niveau courant traitée par le thread t
+static void bfsNiveau(TravailleurBfs *t) {
+    if (t->b->montant) bfsMontant(t);
+    else if (t->b->seul) bfsDescendantSeul(t);
+    else bfsDescendant(t);
+    if (t->nb > 0) bfsVider(t);
+}
+
+static void* bfsTravailleur(void *arg) {
+    TravailleurBfs *t = arg;
+    BfsParallele *b = t->b;
+    pthread_mutex_lock(&b->verrouDepart);
+    while (!b->partez) pthread_cond_wait(&b->depart, &b->verrouDepart);
+    pthread_mutex_unlock(&b->verrouDepart);
+
+    for (;;) {
+        if (t->id == 0) {
+            bfsPreparer(b);
+            while (!b->fini && b->seul) {
+                bfsNiveau(t);
+                bfsPreparer(b);
+            }
+        }
+        pthread_barrier_wait(&b->barriere);
+        if (b->fini) break;
+        bfsNiveau(t);
+        pthread_barrier_wait(&b->barriere);
+    }
+    return NULL;
+}
+
+// BFS commun à construireNiveaux et construireNiveauxBits (libres nul : test capa[e] >= delta)
+static DinicStatut niveauxParalleles(Contexte *ctx, const Graphe *rg, Capacite delta, const uint64_t *libres,
+                                     int *niveau, bool *atteint) {
+    size_t n = (size_t)rg->nbSommets, nbMots = (n + 63) / 64;
+    BfsParallele b = { .rg = rg, .delta = delta, .libres = libres, .niveau = niveau, .nbMots = (int)nbMots,
+                       .niveauCourant = -1, .queue = 1 };
+    b.file      = reserverTampon(ctx, T_FILE, n * sizeof *b.file);
+    b.visite    = reserverTampon(ctx, T_VISITE, nbMots * sizeof *b.visite);
+    b.frontiere = reserverTampon(ctx, T_BITS_FRONTIERE, nbMots * sizeof *b.frontiere);
+    if (!b.file || !b.visite || !b.frontiere) return DINIC_ERREUR_MEMOIRE;
+
+    for (size_t i = 0; i < n; i++) niveau[i] = -1;
+    memset(b.visite, 0, nbMots * sizeof *b.visite);
+    b.file[0] = rg->source;
+    niveau[rg->source] = 0;
+    b.visite[rg->source >> 6] |= (uint64_t)1 << (rg->source & 63);
+
+    int nbThreads = (rg->nbArcs < BFS_SEUIL_PARALLELE) ? 1 : nombreThreads(ctx);
+    if (nbThreads > BFS_MAX_THREADS) nbThreads = BFS_MAX_THREADS;
+    pthread_mutex_init(&b.verrouDepart, NULL);
+    pthread_cond_init(&b.depart, NULL);
+
+    pthread_t threads[BFS_MAX_THREADS];
+    TravailleurBfs travailleurs[BFS_MAX_THREADS];
+    int lances = 1;
+    travailleurs[0] = (TravailleurBfs){ .b = &b, .id = 0 };
+    for (int t = 1; t < nbThreads; t++, lances++) {
+        travailleurs[t] = (TravailleurBfs){ .b = &b, .id = t };
+        if (pthread_create(&threads[t], NULL, bfsTravailleur, &travailleurs[t]) != 0) break;
+    }
+    b.nbThreads = lances;
+    pthread_barrier_init(&b.barriere, NULL, lances);
+    pthread_mutex_lock(&b.verrouDepart);
+    b.partez = true;
+    pthread_cond_broadcast(&b.depart);
+    pthread_mutex_unlock(&b.verrouDepart);
+
+    bfsTravailleur(&travailleurs[0]);
+    for (int t = 1; t < lances; t++) pthread_join(threads[t], NULL);
+    pthread_barrier_destroy(&b.barriere);
+    pthread_cond_destroy(&b.depart);
+    pthread_mutex_destroy(&b.verrouDepart);
+
+    int64_t arcs = 0;
+    for (int t = 0; t < lances; t++) arcs += travailleurs[t].arcs;
+    ctx->stats.arcsParcourus += arcs;
+    *atteint = niveau[rg->puits] >= 0;
+    return DINIC_OK;
+}
+
+/***********************************************************************************************************/
+/* Action construireNiveaux :                                                                              */
+/*   - même résultat que buildLevelGraph (niveau[v] = distance de la source par les arcs de capacité       */
+/*     >= delta, -1 au-delà du niveau du puits), calculé par le BFS parallèle à direction optimisée        */
+/*   - threads du contexte ; un seul thread sous BFS_SEUIL_PARALLELE arcs ; si une création de thread      */
+/*     échoue, le BFS se poursuit avec les threads déjà lancés                                             */
+/*   - paramètres : Contexte* ctx, const Graphe* rg, Capacite delta, int* niveau (n cases),                */
+/*                  bool* atteint (vrai si le puits est atteint)                                           */
+/*   - retourne : DINIC_OK ou DINIC_ERREUR_MEMOIRE                                                         */
+/***********************************************************************************************************/
+DinicStatut construireNiveaux(Contexte *ctx, const Graphe *rg, Capacite delta, int *niveau, bool *atteint) {
+    return niveauxParalleles(ctx, rg, delta, NULL, niveau, atteint);
+}
+
+/***********************************************************************************************************/
+/* Action construireNiveauxBits :                                                                          */
+/*   - construireNiveaux sur un résiduel tenu en bits (arc e utilisable si le bit e de libres est à 1)     */
+/***********************************************************************************************************/
+DinicStatut construireNiveauxBits(Contexte *ctx, const Graphe *rg, const uint64_t *libres, int *niveau, bool *atteint) {
+    return niveauxParalleles(ctx, rg, 1, libres, niveau, atteint);
+}
@@ -0,0 +1,203 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "dinic_interne.h"
+
+// -----------------------------------------------------------------------------
+// Cache binaire du réseau initial
+//
+// Le fichier contient un en-tête suivi des trois tableaux CSR du réseau, chacun
+// aligné sur BINAIRE_ALIGNEMENT octets :
+//   [EnTeteBinaire][debut : nbSommets+1 int][SommetDest : nbArcs int][capa : nbArcs Capacite]
+// Au chargement le fichier est projeté en mémoire et les tableaux du Graphe
+// pointent directement dans la projection : ni analyse, ni copie.
+// - magie / version : identification du format, refusé s'il ne correspond pas
+// - boutisme        : BINAIRE_BOUTISME écrit en natif, refusé sur une machine
+//                     d'ordre des octets différent
+// - pos*            : position de chaque tableau dans le fichier
+// -----------------------------------------------------------------------------
+#define BINAIRE_MAGIE      "DINICBIN"
+#define BINAIRE_VERSION    1
+#define BINAIRE_BOUTISME   0x01020304u
+#define BINAIRE_ALIGNEMENT 64
+
+typedef struct {
+    char     magie[8];
+    uint32_t version;
+    uint32_t boutisme;
+    int64_t  nbSommets, nbArcs;
+    int64_t  source, puits;
+    uint64_t posDebut, posDest, posCapa;
+    uint64_t tailleTotale;
+} EnTeteBinaire;
+
+static uint64_t aligner(uint64_t pos) {
+    return (pos + BINAIRE_ALIGNEMENT - 1) / BINAIRE_ALIGNEMENT * BINAIRE_ALIGNEMENT;
+}
+
+static EnTeteBinaire enTete(const Graphe *g) {
+    EnTeteBinaire t = { .version = BINAIRE_VERSION, .boutisme = BINAIRE_BOUTISME,
+                        .nbSommets = g->nbSommets, .nbArcs = g->nbArcs,
+                        .source = g->source, .puits = g->puits };
+    memcpy(t.magie, BINAIRE_MAGIE, sizeof t.magie);
+    t.posDebut = aligner(sizeof t);
+    t.posDest = aligner(t.posDebut + ((uint64_t)g->nbSommets + 1) * sizeof(int));
+    t.posCapa = aligner(t.posDest + (uint64_t)g->nbArcs * sizeof(int));
+    t.tailleTotale = t.posCapa + (uint64_t)g->nbArcs * sizeof(Capacite);
+    return t;
+}
+
+static bool ecrireA(FILE *f, uint64_t pos, const void *donnees, size_t octets) {
+    static const char zeros[BINAIRE_ALIGNEMENT];
+    long ici = ftell(f);
+    if (ici < 0 || (uint64_t)ici > pos) return false;
+    if (fwrite(zeros, 1, pos - (uint64_t)ici, f) != pos - (uint64_t)ici) return false;
+    return octets == 0 || fwrite(donnees, 1, octets, f) == octets;
+}
+
+/***********************************************************************************************************/
+/* Action ecrireGrapheBinaire :                                                                            */
+/*   - écrit le réseau initial (sommets, source, puits, tableaux CSR) dans le cache binaire 'chemin'       */
+/*   - le fichier est écrit sous un nom temporaire puis renommé : un cache n'est jamais lu à moitié écrit  */
+/***********************************************************************************************************/
+DinicStatut ecrireGrapheBinaire(Contexte *ctx, const Graphe *g, const char *chemin) {
+    ctx->erreur[0] = '\0';
+    char temporaire[4096];
+    if (snprintf(temporaire, sizeof temporaire, "%s.tmp", chemin) >= (int)sizeof temporaire) {
+        return fixerErreur(ctx, DINIC_ERREUR_PARAMETRE, "%s : chemin trop long", chemin);
+    }
+    FILE *f = fopen(temporaire, "wb");
+    if (!f) return fixerErreur(ctx, DINIC_ERREUR_FICHIER, "%s : %s", temporaire, strerror(errno));
+
+    EnTeteBinaire t = enTete(g);
+    bool ok = ecrireA(f, 0, &t, sizeof t) &&
+              ecrireA(f, t.posDebut, g->debut, ((size_t)g->nbSommets + 1) * sizeof *g->debut) &&
+              ecrireA(f, t.posDest, g->SommetDest, (size_t)g->nbArcs * sizeof *g->SommetDest) &&
+              ecrireA(f, t.posCapa, g->capa, (size_t)g->nbArcs * sizeof *g->capa);
+    int erreur = errno;
+    if (fclose(f) != 0 && ok) { ok = false; erreur = errno; }
+    if (ok && rename(temporaire, chemin) != 0) { ok = false; erreur = errno; }
+    if (!ok) {
+        remove(temporaire);
+        return fixerErreur(ctx, DINIC_ERREUR_FICHIER, "écriture de %s : %s", chemin, strerror(erreur));
+    }
+    return DINIC_OK;
+}
+
+/***********************************************************************************************************/
+/* Action lireGrapheBinaire :                                                                              */
+/*   - projette le cache binaire en mémoire (copie à l'écriture) : debut, SommetDest et capa pointent      */
+/*     dans la projection, seuls flot et arcResiduel sont alloués ; freeGraph libère la projection         */
+/*   - l'en-tête est vérifié (format, version, ordre des octets, tailles), pas le contenu des tableaux :   */
+/*     le fichier doit provenir de ecrireGrapheBinaire                                                     */
+/***********************************************************************************************************/
+DinicStatut lireGrapheBinaire(Contexte *ctx, const char *chemin, Graphe **res) {
+    *res = NULL;
+    ctx->erreur[0] = '\0';
+    double debut = maintenant();
+    int fd = open(chemin, O_RDONLY);
+    if (fd < 0) return fixerErreur(ctx, DINIC_ERREUR_FICHIER, "%s : %s", chemin, strerror(errno));
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return fixerErreur(ctx, DINIC_ERREUR_FICHIER, "%s : %s", chemin, strerror(errno));
+    }
+    size_t taille = (size_t)st.st_size;
+    if (taille < sizeof(EnTeteBinaire)) {
+        close(fd);
+        return fixerErreur(ctx, DINIC_ERREUR_FORMAT, "%s : fichier binaire tronqué", chemin);
+    }
+    char *base = mmap(NULL, taille, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return fixerErreur(ctx, DINIC_ERREUR_FICHIER, "%s : mmap : %s", chemin, strerror(errno));
+
+    EnTeteBinaire t;
+    memcpy(&t, base, sizeof t);
+    const char *motif = NULL;
+    if (memcmp(t.magie, BINAIRE_MAGIE, sizeof t.magie) != 0) motif = "ce n'est pas un graphe binaire";
+    else if (t.version != BINAIRE_VERSION) motif = "version du format non prise en charge";
+    else if (t.boutisme != BINAIRE_BOUTISME) motif = "ordre des octets différent de cette machine";
+    else if (t.nbSommets < 2 || t.nbSommets >= INT32_MAX || t.nbArcs < 0 || t.nbArcs > INT32_MAX ||
+             t.source < 1 || t.source >= t.nbSommets || t.puits < 1 || t.puits >= t.nbSommets) {
+        motif = "en-tête incohérent";
+    } else {
+        Graphe g = { .nbSommets = (int)t.nbSommets, .nbArcs = (int)t.nbArcs };
+        EnTeteBinaire attendu = enTete(&g);
+        if (t.posDebut != attendu.posDebut || t.posDest != attendu.posDest || t.posCapa != attendu.posCapa ||
+            t.tailleTotale != attendu.tailleTotale || t.tailleTotale != taille) {
+            motif = "taille du fichier incohérente";
+        } else {
+            const int *debut = (const int *)(base + t.posDebut);
+            if (debut[0] != 0 || debut[t.nbSommets] != t.nbArcs) motif = "tableau debut incohérent";
+        }
+    }
+    if (motif) {
+        munmap(base, taille);
+        return fixerErreur(ctx, DINIC_ERREUR_FORMAT, "%s : %s", chemin, motif);
+    }
+
+    Graphe *g = calloc(1, sizeof *g);
+    size_t m = (t.nbArcs > 0) ? (size_t)t.nbArcs : 1;
+    if (g) {
+        *g = (Graphe){ .nbSommets = (int)t.nbSommets, .nbArcs = (int)t.nbArcs,
+                       .source = (int)t.source, .puits = (int)t.puits,
+                       .debut = (int *)(base + t.posDebut),
+                       .SommetDest = (int *)(base + t.posDest),
+                       .capa = (Capacite *)(base + t.posCapa),
+                       .projection = base, .tailleProjection = taille };
+        g->flot = calloc(m, sizeof *g->flot);
+        g->arcResiduel = malloc(m * sizeof *g->arcResiduel);
+    }
+    if (!g || !g->flot || !g->arcResiduel) {
+        if (g) freeGraph(g);
+        else munmap(base, taille);
+        return fixerErreur(ctx, DINIC_ERREUR_MEMOIRE, "graphe de %" PRId64 " arcs trop grand", t.nbArcs);
+    }
+    *res = g;
+    ctx->stats.tempsChargement += maintenant() - debut;
+    return DINIC_OK;
+}
+
+// -----------------------------------------------------------------------------
+// Fichier binaire des flots (SORTIE_BINAIRE de ecrireResultat)
+//   [EnTeteFlots][flot : nbArcs Capacite]
+// Les flux suivent l'ordre CSR du réseau, celui de debut/SommetDest dans le
+// cache binaire : un lecteur qui a le cache retrouve l'arc de chaque flux.
+// -----------------------------------------------------------------------------
+#define FLOTS_MAGIE   "DINICFLO"
+#define FLOTS_VERSION 1
+
+typedef struct {
+    char     magie[8];
+    uint32_t version;
+    uint32_t boutisme;
+    int64_t  nbSommets, nbArcs;
+    int64_t  source, puits;
+    int64_t  flotTotal;
+    uint64_t posFlot;
+} EnTeteFlots;
+
+DinicStatut ecrireFlotsBinaire(Contexte *ctx, const Graphe *g, Capacite flot_total, const char *chemin) {
+    FILE *f = fopen(chemin, "wb");
+    if (!f) return fixerErreur(ctx, DINIC_ERREUR_FICHIER, "impossible de créer le fichier %s : %s", chemin, strerror(errno));
+    EnTeteFlots t = { .version = FLOTS_VERSION, .boutisme = BINAIRE_BOUTISME,
+                      .nbSommets = g->nbSommets, .nbArcs = g->nbArcs,
+                      .source = g->source, .puits = g->puits, .flotTotal = flot_total,
+                      .posFlot = aligner(sizeof t) };
+    memcpy(t.magie, FLOTS_MAGIE, sizeof t.magie);
+    bool ok = ecrireA(f, 0, &t, sizeof t) &&
+              ecrireA(f, t.posFlot, g->flot, (size_t)g->nbArcs * sizeof *g->flot);
+    int erreur = errno;
+    if (fclose(f) != 0 && ok) { ok = false; erreur = errno; }
+    if (!ok) return fixerErreur(ctx, DINIC_ERREUR_FICHIER, "écriture de %s : %s", chemin, strerror(erreur));
+    return DINIC_OK;
+}
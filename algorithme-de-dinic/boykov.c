@@ -0,0 +1,492 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
+#include "dinic_interne.h"
+
+// -----------------------------------------------------------------------------
+// Algorithme de Boykov-Kolmogorov (2004)
+//
+// Deux arbres de recherche, S enraciné à la source et T enraciné au puits,
+// grandissent l'un vers l'autre à partir des sommets actifs ; chaque contact
+// entre les arbres donne un chemin augmentant. Après l'augmentation, les
+// sommets dont l'arc parent est saturé deviennent orphelins et cherchent un
+// nouveau parent dans leur arbre (adoption) : les arbres ne sont jamais
+// reconstruits, ce qui convient aux grilles de segmentation où les chemins
+// sont courts et très nombreux.
+//
+// Comme dans l'implémentation de Kolmogorov, les arcs de la source et vers le
+// puits sont portés par les sommets : terminal[v] > 0 est la capacité
+// résiduelle source -> v, terminal[v] < 0 celle de v -> puits. Les arcs
+// internes sont ceux d'un graphe CSR ou, pour une grille implicite, l'arc
+// v.K + k vers le k-ième voisin du voxel v (aucun tableau d'arcs).
+// Heuristiques de Kolmogorov : chaque sommet garde une distance à sa racine,
+// datée par 'marque' ; l'adoption choisit le parent le plus proche et la
+// croissance raccroche un sommet à un parent plus proche rencontré en chemin.
+// -----------------------------------------------------------------------------
+#define LIBRE            0
+#define ARBRE_S          1
+#define ARBRE_T          2
+#define PARENT_TERMINAL  (-1)      // racine : rattaché directement à la source ou au puits
+#define PARENT_ORPHELIN  (-2)
+#define INACTIF          (-1)      // hors de la file des actifs
+#define DISTANCE_INFINIE INT_MAX
+
+typedef struct {
+    int  nbSommets;
+    const int *debut, *dest, *inverse;     // graphe CSR ; NULL pour une grille
+    int  nbVoisins;                        // grille : arcs v.K .. v.K + K - 1 du voxel v
+    int  decalage[GRILLE_MAX_VOISINS];     // grille : indice du k-ième voisin moins celui du voxel
+    Capacite *capa;                        // capacités résiduelles des arcs
+    Capacite *terminal;
+    int  *parent;                          // arc v -> parent, PARENT_TERMINAL ou PARENT_ORPHELIN
+    unsigned char *arbre;                  // LIBRE, ARBRE_S ou ARBRE_T
+    int  *marque, *distance;               // heuristiques de distance à la racine
+    int  *suivant;                         // file des actifs (v lui-même en fin de file)
+    int   tete, queue;
+    int  *orphelins;
+    int   debutOrphelins, finOrphelins;
+    int   temps;
+    int64_t chemins, longueur, arcs;
+} ReseauBK;
+
+static inline int premierArc(const ReseauBK *r, int v) {
+    return r->debut ? r->debut[v] : v * r->nbVoisins;
+}
+
+static inline int finArcs(const ReseauBK *r, int v) {
+    return r->debut ? r->debut[v + 1] : (v + 1) * r->nbVoisins;
+}
+
+// extrémité de l'arc a de v ; sur une grille, hors de [0, n) au bord (l'arc a alors une capacité nulle)
+static inline int cible(const ReseauBK *r, int v, int a) {
+    return r->dest ? r->dest[a] : v + r->decalage[a - v * r->nbVoisins];
+}
+
+// arc w -> v apparié à l'arc a = v -> w ; sur une grille, les directions opposées sont k et K-1-k
+static inline int arcInverse(const ReseauBK *r, int v, int w, int a) {
+    return r->inverse ? r->inverse[a] : w * r->nbVoisins + r->nbVoisins - 1 - (a - v * r->nbVoisins);
+}
+
+static void activer(ReseauBK *r, int v) {
+    if (r->suivant[v] != INACTIF) return;
+    r->suivant[v] = v;
+    if (r->queue >= 0) r->suivant[r->queue] = v;
+    else r->tete = v;
+    r->queue = v;
+}
+
+// prochain sommet actif encore dans un arbre, -1 si la file est vide
+static int prochainActif(ReseauBK *r) {
+    while (r->tete >= 0) {
+        int v = r->tete, s = r->suivant[v];
+        r->tete = (s == v) ? -1 : s;
+        if (r->tete < 0) r->queue = -1;
+        r->suivant[v] = INACTIF;
+        if (r->arbre[v] != LIBRE) return v;
+    }
+    return -1;
+}
+
+static void rendreOrphelin(ReseauBK *r, int v) {
+    r->parent[v] = PARENT_ORPHELIN;
+    r->orphelins[r->finOrphelins++] = v;
+}
+
+/***********************************************************************************************************/
+/* Action augmenter :                                                                                      */
+/*   - pousse le goulot du chemin source -> ... -> p -> q -> ... -> puits (milieu = arc p -> q, p dans S,  */
+/*     q dans T) ; les sommets dont l'arc parent ou terminal est saturé deviennent orphelins               */
+/*   - retourne : Capacite (flot poussé)                                                                   */
+/***********************************************************************************************************/
+static Capacite augmenter(ReseauBK *r, int milieu, int p, int q) {
+    Capacite *capa = r->capa, *terminal = r->terminal;
+    Capacite k = capa[milieu];
+    int64_t longueur = 3;
+    for (int v = p;;) {
+        int a = r->parent[v];
+        if (a == PARENT_TERMINAL) {
+            if (terminal[v] < k) k = terminal[v];
+            break;
+        }
+        int w = cible(r, v, a);
+        Capacite c = capa[arcInverse(r, v, w, a)];
+        if (c < k) k = c;
+        v = w;
+        longueur++;
+    }
+    for (int v = q;;) {
+        int a = r->parent[v];
+        if (a == PARENT_TERMINAL) {
+            if (-terminal[v] < k) k = -terminal[v];
+            break;
+        }
+        if (capa[a] < k) k = capa[a];
+        v = cible(r, v, a);
+        longueur++;
+    }
+
+    capa[milieu] -= k;
+    capa[arcInverse(r, p, q, milieu)] += k;
+    for (int v = p;;) {
+        int a = r->parent[v];
+        if (a == PARENT_TERMINAL) {
+            terminal[v] -= k;
+            if (terminal[v] == 0) rendreOrphelin(r, v);
+            break;
+        }
+        int w = cible(r, v, a), b = arcInverse(r, v, w, a);
+        capa[a] += k;
+        capa[b] -= k;
+        if (capa[b] == 0) rendreOrphelin(r, v);
+        v = w;
+    }
+    for (int v = q;;) {
+        int a = r->parent[v];
+        if (a == PARENT_TERMINAL) {
+            terminal[v] += k;
+            if (terminal[v] == 0) rendreOrphelin(r, v);
+            break;
+        }
+        int w = cible(r, v, a);
+        capa[a] -= k;
+        capa[arcInverse(r, v, w, a)] += k;
+        if (capa[a] == 0) rendreOrphelin(r, v);
+        v = w;
+    }
+    r->chemins++;
+    r->longueur += longueur;
+    return k;
+}
+
+/***********************************************************************************************************/
+/* Action adopter :                                                                                        */
+/*   - traite les orphelins dans l'ordre : le nouveau parent est le voisin du même arbre, relié par un arc */
+/*     résiduel, dont la remontée atteint la racine (et non un orphelin) au plus court ; les sommets       */
+/*     remontés sont datés pour ne pas les reparcourir                                                     */
+/*   - sans parent possible, l'orphelin devient libre : ses voisins de l'arbre reliés par un arc résiduel  */
+/*     redeviennent actifs et ses enfants deviennent orphelins à leur tour                                 */
+/***********************************************************************************************************/
+static void adopter(ReseauBK *r) {
+    const Capacite *capa = r->capa;
+    int *parent = r->parent, *marque = r->marque, *distance = r->distance;
+    const unsigned char *arbre = r->arbre;
+    const unsigned n = (unsigned)r->nbSommets;
+    while (r->debutOrphelins < r->finOrphelins) {
+        int i = r->orphelins[r->debutOrphelins++];
+        int cote = arbre[i], debut = premierArc(r, i), fin = finArcs(r, i);
+        int meilleur = PARENT_ORPHELIN, dMin = DISTANCE_INFINIE;
+        r->arcs += fin - debut;
+        for (int a = debut; a < fin; a++) {
+            int w = cible(r, i, a);
+            if ((unsigned)w >= n || arbre[w] != cote) continue;
+            if ((cote == ARBRE_S ? capa[arcInverse(r, i, w, a)] : capa[a]) == 0) continue;
+            int d = 0, j = w;
+            for (;;) {
+                if (marque[j] == r->temps) {
+                    d += distance[j];
+                    break;
+                }
+                int b = parent[j];
+                d++;
+                if (b == PARENT_TERMINAL) {
+                    marque[j] = r->temps;
+                    distance[j] = 1;
+                    break;
+                }
+                if (b == PARENT_ORPHELIN) {
+                    d = DISTANCE_INFINIE;
+                    break;
+                }
+                j = cible(r, j, b);
+            }
+            if (d == DISTANCE_INFINIE) continue;
+            if (d < dMin) {
+                meilleur = a;
+                dMin = d;
+            }
+            for (j = w; marque[j] != r->temps; j = cible(r, j, parent[j])) {
+                marque[j] = r->temps;
+                distance[j] = d--;
+            }
+        }
+        if (meilleur != PARENT_ORPHELIN) {
+            parent[i] = meilleur;
+            marque[i] = r->temps;
+            distance[i] = dMin + 1;
+            continue;
+        }
+
+        for (int a = debut; a < fin; a++) {
+            int w = cible(r, i, a);
+            if ((unsigned)w >= n || arbre[w] != cote) continue;
+            int b = parent[w];
+            if (b >= 0 && cible(r, w, b) == i) rendreOrphelin(r, w);
+            if ((cote == ARBRE_S ? capa[arcInverse(r, i, w, a)] : capa[a]) > 0) activer(r, w);
+        }
+        r->arbre[i] = LIBRE;
+    }
+}
+
+// zones de travail des arbres, réservées avant toute modification du réseau
+static DinicStatut reserverArbres(Contexte *ctx, ReseauBK *r) {
+    size_t n = (size_t)r->nbSommets;
+    r->parent    = reserverTampon(ctx, T_PARENT, n * sizeof *r->parent);
+    r->arbre     = reserverTampon(ctx, T_ARBRE, n * sizeof *r->arbre);
+    r->marque    = reserverTampon(ctx, T_MARQUE, n * sizeof *r->marque);
+    r->distance  = reserverTampon(ctx, T_DISTANCE, n * sizeof *r->distance);
+    r->suivant   = reserverTampon(ctx, T_ACTIFS, n * sizeof *r->suivant);
+    r->orphelins = reserverTampon(ctx, T_ORPHELINS, n * sizeof *r->orphelins);
+    if (!r->parent || !r->arbre || !r->marque || !r->distance || !r->suivant || !r->orphelins) {
+        return DINIC_ERREUR_MEMOIRE;
+    }
+    return DINIC_OK;
+}
+
+/***********************************************************************************************************/
+/* Action boykovKolmogorovCoeur :                                                                          */
+/*   - flot maximal du réseau r (capacités et terminal initialisés, modifiés en place, zones de travail    */
+/*     réservées par reserverArbres) ; à la fin, les sommets de l'arbre S (arbre[v] == ARBRE_S) forment    */
+/*     le côté source d'une coupe minimale                                                                 */
+/*   - retourne : Capacite (flot poussé par les chemins augmentants)                                       */
+/***********************************************************************************************************/
+static Capacite boykovKolmogorovCoeur(Contexte *ctx, ReseauBK *r) {
+    size_t n = (size_t)r->nbSommets;
+    double t0 = maintenant();
+    Capacite *capa = r->capa, *terminal = r->terminal, total = 0;
+    r->tete = r->queue = -1;
+    r->temps = 0;
+    for (size_t v = 0; v < n; v++) {
+        r->parent[v] = PARENT_TERMINAL;
+        r->marque[v] = 0;
+        r->distance[v] = 1;
+        r->suivant[v] = INACTIF;
+        r->arbre[v] = (terminal[v] > 0) ? ARBRE_S : (terminal[v] < 0) ? ARBRE_T : LIBRE;
+        if (r->arbre[v] != LIBRE) activer(r, (int)v);
+    }
+
+    int courant = -1;
+    for (;;) {
+        int i = courant;
+        if (i >= 0) {
+            r->suivant[i] = INACTIF;
+            if (r->arbre[i] == LIBRE) i = -1;
+        }
+        if (i < 0 && (i = prochainActif(r)) < 0) break;
+
+        // croissance : S par les arcs i -> w, T par les arcs w -> i
+        int milieu = -1, p = -1, q = -1, debut = premierArc(r, i), fin = finArcs(r, i);
+        r->arcs += fin - debut;
+        if (r->arbre[i] == ARBRE_S) {
+            for (int a = debut; a < fin; a++) {
+                if (capa[a] == 0) continue;
+                int w = cible(r, i, a);
+                if (r->arbre[w] == LIBRE) {
+                    r->arbre[w] = ARBRE_S;
+                    r->parent[w] = arcInverse(r, i, w, a);
+                    r->marque[w] = r->marque[i];
+                    r->distance[w] = r->distance[i] + 1;
+                    activer(r, w);
+                } else if (r->arbre[w] == ARBRE_T) {
+                    milieu = a, p = i, q = w;
+                    break;
+                } else if (r->marque[w] <= r->marque[i] && r->distance[w] > r->distance[i]) {
+                    r->parent[w] = arcInverse(r, i, w, a);
+                    r->marque[w] = r->marque[i];
+                    r->distance[w] = r->distance[i] + 1;
+                }
+            }
+        } else {
+            for (int a = debut; a < fin; a++) {
+                int w = cible(r, i, a);
+                if ((unsigned)w >= (unsigned)n) continue;
+                int b = arcInverse(r, i, w, a);
+                if (capa[b] == 0) continue;
+                if (r->arbre[w] == LIBRE) {
+                    r->arbre[w] = ARBRE_T;
+                    r->parent[w] = b;
+                    r->marque[w] = r->marque[i];
+                    r->distance[w] = r->distance[i] + 1;
+                    activer(r, w);
+                } else if (r->arbre[w] == ARBRE_S) {
+                    milieu = b, p = w, q = i;
+                    break;
+                } else if (r->marque[w] <= r->marque[i] && r->distance[w] > r->distance[i]) {
+                    r->parent[w] = b;
+                    r->marque[w] = r->marque[i];
+                    r->distance[w] = r->distance[i] + 1;
+                }
+            }
+        }
+
+        r->temps++;
+        if (milieu < 0) {
+            courant = -1;
+            continue;
+        }
+        // i reste en tête : il peut toucher l'autre arbre par d'autres arcs
+        r->suivant[i] = i;
+        courant = i;
+        r->debutOrphelins = r->finOrphelins = 0;
+        total += augmenter(r, milieu, p, q);
+        adopter(r);
+    }
+
+    Statistiques *st = &ctx->stats;
+    st->tempsAugmentation += maintenant() - t0;
+    st->nbChemins += r->chemins;
+    st->longueurChemins += r->longueur;
+    st->arcsParcourus += r->arcs;
+    return total;
+}
+
+/***********************************************************************************************************/
+/* Action boykovKolmogorov :                                                                               */
+/*   - les arcs de la source et vers le puits sont retirés du graphe résiduel le temps du calcul et        */
+/*     cumulés en capacités terminales ; ils sont ensuite remis et reçoivent le flot terminal de chaque    */
+/*     sommet, réparti dans l'ordre des arcs parallèles ; les arcs source -> puits sont saturés d'emblée   */
+/***********************************************************************************************************/
+DinicStatut boykovKolmogorov(Contexte *ctx, Graphe *rg, Capacite *flot) {
+    size_t n = (size_t)rg->nbSommets;
+    int s = rg->source, t = rg->puits;
+    size_t nbTerminaux = (size_t)(rg->debut[s + 1] - rg->debut[s]) + (size_t)(rg->debut[t + 1] - rg->debut[t]);
+    Capacite *terminal   = reserverTampon(ctx, T_TERMINAL, n * sizeof *terminal);
+    Capacite *capaSource = reserverTampon(ctx, T_CAPA_SOURCE, n * sizeof *capaSource);
+    Capacite *capaPuits  = reserverTampon(ctx, T_CAPA_PUITS, n * sizeof *capaPuits);
+    Capacite *sauvegarde = reserverTampon(ctx, T_SAUVEGARDE, 2 * nbTerminaux * sizeof *sauvegarde);
+    ReseauBK r = { .nbSommets = (int)n, .debut = rg->debut, .dest = rg->SommetDest, .inverse = rg->inverse,
+                   .capa = rg->capa, .terminal = terminal };
+    if (!terminal || !capaSource || !capaPuits || !sauvegarde || reserverArbres(ctx, &r) != DINIC_OK) {
+        return DINIC_ERREUR_MEMOIRE;
+    }
+
+    Capacite *capa = rg->capa, total = 0;
+    const int *dest = rg->SommetDest, *inverse = rg->inverse;
+    memset(capaSource, 0, n * sizeof *capaSource);
+    memset(capaPuits, 0, n * sizeof *capaPuits);
+    size_t k = 0;
+    for (int a = rg->debut[s]; a < rg->debut[s + 1]; a++) {
+        int v = dest[a];
+        if (v == t) {
+            total += capa[a];
+            capa[inverse[a]] += capa[a];
+            capa[a] = 0;
+        }
+        if (v == s || v == t) continue;
+        sauvegarde[k++] = capa[a];
+        sauvegarde[k++] = capa[inverse[a]];
+        capaSource[v] += capa[a];
+        capa[a] = capa[inverse[a]] = 0;
+    }
+    for (int a = rg->debut[t]; a < rg->debut[t + 1]; a++) {
+        int v = dest[a];
+        if (v == s || v == t) continue;
+        sauvegarde[k++] = capa[a];
+        sauvegarde[k++] = capa[inverse[a]];
+        capaPuits[v] += capa[inverse[a]];
+        capa[a] = capa[inverse[a]] = 0;
+    }
+    for (size_t v = 0; v < n; v++) {
+        terminal[v] = capaSource[v] - capaPuits[v];
+        total += (capaSource[v] < capaPuits[v]) ? capaSource[v] : capaPuits[v];
+    }
+
+    total += boykovKolmogorovCoeur(ctx, &r);
+
+    // arcs terminaux remis, puis flot terminal de chaque sommet reporté sur ses arcs
+    k = 0;
+    for (int a = rg->debut[s]; a < rg->debut[s + 1]; a++) {
+        if (dest[a] == s || dest[a] == t) continue;
+        capa[a] = sauvegarde[k++];
+        capa[inverse[a]] = sauvegarde[k++];
+    }
+    for (int a = rg->debut[t]; a < rg->debut[t + 1]; a++) {
+        if (dest[a] == s || dest[a] == t) continue;
+        capa[a] = sauvegarde[k++];
+        capa[inverse[a]] = sauvegarde[k++];
+    }
+    for (size_t v = 0; v < n; v++) {
+        capaSource[v] -= (terminal[v] > 0) ? terminal[v] : 0;
+        capaPuits[v]  -= (terminal[v] < 0) ? -terminal[v] : 0;
+    }
+    for (int a = rg->debut[s]; a < rg->debut[s + 1]; a++) {
+        int v = dest[a];
+        if (v == s || v == t) continue;
+        Capacite d = (capaSource[v] < capa[a]) ? capaSource[v] : capa[a];
+        capa[a] -= d;
+        capa[inverse[a]] += d;
+        capaSource[v] -= d;
+    }
+    for (int a = rg->debut[t]; a < rg->debut[t + 1]; a++) {
+        int v = dest[a], b = inverse[a];
+        if (v == s || v == t) continue;
+        Capacite d = (capaPuits[v] < capa[b]) ? capaPuits[v] : capa[b];
+        capa[b] -= d;
+        capa[a] += d;
+        capaPuits[v] -= d;
+    }
+    *flot = total;
+    return DINIC_OK;
+}
+
+/***********************************************************************************************************/
+/* Action flotGrille :                                                                                     */
+/*   - vérifie la grille (capacités >= 0, aucun arc vers l'extérieur) puis applique le cœur directement    */
+/*     sur ses tableaux : voisins devient résiduel en place, source et puits reçoivent les capacités       */
+/*     terminales résiduelles                                                                              */
+/***********************************************************************************************************/
+DinicStatut flotGrille(Contexte *ctx, Grille *g, Capacite *flot, uint64_t *coupe) {
+    ctx->erreur[0] = '\0';
+    DinicStatut statut = controlerGrille(ctx, g->largeur, g->hauteur, g->profondeur, g->connexite);
+    if (statut != DINIC_OK) return statut;
+    int directions[GRILLE_MAX_VOISINS][3];
+    int K = directionsGrille(g->connexite, directions);
+    int n = g->largeur * g->hauteur * g->profondeur;
+    for (int v = 0, x = 0, y = 0, z = 0; v < n; v++) {
+        if (g->source[v] < 0 || g->puits[v] < 0) {
+            return fixerErreur(ctx, DINIC_ERREUR_PARAMETRE, "capacité terminale négative (voxel %d %d %d)", x, y, z);
+        }
+        for (int k = 0; k < K; k++) {
+            Capacite c = g->voisins[(size_t)v * K + k];
+            int xv = x + directions[k][0], yv = y + directions[k][1], zv = z + directions[k][2];
+            bool dedans = xv >= 0 && xv < g->largeur && yv >= 0 && yv < g->hauteur && zv >= 0 && zv < g->profondeur;
+            if (c < 0 || (c > 0 && !dedans)) {
+                return fixerErreur(ctx, DINIC_ERREUR_PARAMETRE, "capacité invalide du voxel %d %d %d vers %d %d %d",
+                                   x, y, z, xv, yv, zv);
+            }
+        }
+        if (++x == g->largeur) {
+            x = 0;
+            if (++y == g->hauteur) y = 0, z++;
+        }
+    }
+
+    Capacite *terminal = reserverTampon(ctx, T_TERMINAL, (size_t)n * sizeof *terminal);
+    ReseauBK r = { .nbSommets = n, .nbVoisins = K, .capa = g->voisins, .terminal = terminal };
+    if (!terminal || reserverArbres(ctx, &r) != DINIC_OK) return DINIC_ERREUR_MEMOIRE;
+    for (int k = 0; k < K; k++) {
+        r.decalage[k] = directions[k][0] + g->largeur * (directions[k][1] + g->hauteur * directions[k][2]);
+    }
+
+    double debut = maintenant();
+    Capacite total = 0;
+    for (int v = 0; v < n; v++) {
+        terminal[v] = g->source[v] - g->puits[v];
+        total += (g->source[v] < g->puits[v]) ? g->source[v] : g->puits[v];
+    }
+    total += boykovKolmogorovCoeur(ctx, &r);
+    for (int v = 0; v < n; v++) {
+        g->source[v] = (terminal[v] > 0) ? terminal[v] : 0;
+        g->puits[v]  = (terminal[v] < 0) ? -terminal[v] : 0;
+    }
+    if (coupe) {
+        memset(coupe, 0, ((size_t)n + 63) / 64 * sizeof *coupe);
+        for (int v = 0; v < n; v++) {
+            if (r.arbre[v] == ARBRE_S) coupe[v >> 6] |= (uint64_t)1 << (v & 63);
+        }
+    }
+    ctx->stats.tempsResolution += maintenant() - debut;
+    *flot = total;
+    return DINIC_OK;
+}
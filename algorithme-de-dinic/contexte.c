@@ -0,0 +1,140 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include "dinic_interne.h"
+
+/***********************************************************************************************************/
+/* Action creerContexte / libererContexte :                                                                */
+/*   - le contexte est créé sans zone de travail ; elles sont allouées à la première résolution            */
+/***********************************************************************************************************/
+Contexte* creerContexte(void) {
+    Contexte *ctx = calloc(1, sizeof *ctx);
+    return ctx;
+}
+
+void libererContexte(Contexte *ctx) {
+    if (!ctx) return;
+    for (int i = 0; i < NB_TAMPONS; i++) free(ctx->tampons[i].donnees);
+    free(ctx);
+}
+
+void definirThreads(Contexte *ctx, int nbThreads) {
+    ctx->nbThreads = (nbThreads > 0) ? nbThreads : 0;
+}
+
+int nombreThreads(const Contexte *ctx) {
+    if (ctx->nbThreads > 0) return ctx->nbThreads;
+    long nbCpu = sysconf(_SC_NPROCESSORS_ONLN);
+    return (nbCpu > 0) ? (int)nbCpu : 1;
+}
+
+/***********************************************************************************************************/
+/* Action statistiques / remettreStatistiques / maintenant :                                               */
+/*   - les moteurs cumulent leurs compteurs dans des variables locales et ne les ajoutent au contexte      */
+/*     qu'en fin de phase : l'instrumentation ne coûte que quelques lectures d'horloge par phase           */
+/***********************************************************************************************************/
+const Statistiques* statistiques(Contexte *ctx) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) ctx->stats.memoirePicKo = usage.ru_maxrss;
+    return &ctx->stats;
+}
+
+void remettreStatistiques(Contexte *ctx) {
+    ctx->stats = (Statistiques){ 0 };
+}
+
+double maintenant(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+/***********************************************************************************************************/
+/* Action derniereErreur / texteStatut / fixerErreur / ajouterErreur :                                     */
+/*   - gestion du message d'erreur du contexte (tronqué à TAILLE_MESSAGE_ERREUR octets)                    */
+/***********************************************************************************************************/
+const char* derniereErreur(const Contexte *ctx) {
+    return ctx->erreur;
+}
+
+const char* texteStatut(DinicStatut statut) {
+    switch (statut) {
+    case DINIC_OK:               return "succès";
+    case DINIC_ERREUR_MEMOIRE:   return "mémoire insuffisante";
+    case DINIC_ERREUR_FICHIER:   return "erreur de fichier";
+    case DINIC_ERREUR_FORMAT:    return "fichier DIMACS invalide";
+    case DINIC_ERREUR_PARAMETRE: return "paramètre invalide";
+    }
+    return "erreur inconnue";
+}
+
+DinicStatut fixerErreur(Contexte *ctx, DinicStatut statut, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vsnprintf(ctx->erreur, sizeof ctx->erreur, format, args);
+    va_end(args);
+    return statut;
+}
+
+void ajouterErreur(Contexte *ctx, const char *format, ...) {
+    size_t lg = strlen(ctx->erreur);
+    if (lg + 1 >= sizeof ctx->erreur) return;
+    if (lg > 0) ctx->erreur[lg++] = '\n';
+    va_list args;
+    va_start(args, format);
+    vsnprintf(ctx->erreur + lg, sizeof ctx->erreur - lg, format, args);
+    va_end(args);
+}
+
+/***********************************************************************************************************/
+/* Action reserverTampon :                                                                                 */
+/*   - une zone n'est réallouée que si la demande dépasse sa taille actuelle ; elle grandit alors d'au     */
+/*     moins moitié pour amortir une suite de graphes de tailles croissantes                               */
+/***********************************************************************************************************/
+void* reserverTampon(Contexte *ctx, int id, size_t octets) {
+    Tampon *t = &ctx->tampons[id];
+    if (octets == 0) octets = 1;
+    if (octets > t->taille) {
+        size_t taille = t->taille + t->taille / 2;
+        if (taille < octets) taille = octets;
+        void *p = realloc(t->donnees, taille);
+        if (!p) {
+            fixerErreur(ctx, DINIC_ERREUR_MEMOIRE, "allocation de %zu octets impossible", taille);
+            return NULL;
+        }
+        t->donnees = p;
+        t->taille = taille;
+    }
+    return t->donnees;
+}
+
+/***********************************************************************************************************/
+/* Action resoudre :                                                                                       */
+/*   - aiguille vers le moteur demandé après avoir vérifié la cohérence du graphe résiduel                 */
+/*   - Dinic et Dinic par mise à l'échelle passent par dinicUnitaire sur un réseau unitaire                */
+/***********************************************************************************************************/
+DinicStatut resoudre(Contexte *ctx, Graphe *rg, Algorithme algo, Capacite *flot) {
+    ctx->erreur[0] = '\0';
+    if (!rg || !rg->inverse || rg->source < 1 || rg->source >= rg->nbSommets ||
+        rg->puits < 1 || rg->puits >= rg->nbSommets) {
+        return fixerErreur(ctx, DINIC_ERREUR_PARAMETRE, "graphe résiduel invalide");
+    }
+    double debut = maintenant();
+    DinicStatut statut;
+    switch (algo) {
+    case ALGO_DINIC:     statut = estUnitaire(rg) ? flotUnitaire(ctx, rg, flot) : dinic(ctx, rg, flot); break;
+    case ALGO_SCALING:   statut = estUnitaire(rg) ? flotUnitaire(ctx, rg, flot) : dinicScaling(ctx, rg, flot); break;
+    case ALGO_HIPR:      statut = pushRelabel(ctx, rg, flot); break;
+    case ALGO_PARALLELE: statut = pushRelabelParallele(ctx, rg, flot); break;
+    case ALGO_BK:        statut = boykovKolmogorov(ctx, rg, flot); break;
+    default:
+        return fixerErreur(ctx, DINIC_ERREUR_PARAMETRE, "algorithme inconnu (%d)", (int)algo);
+    }
+    ctx->stats.tempsResolution += maintenant() - debut;
+    return statut;
+}
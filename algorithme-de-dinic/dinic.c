@@ -1,321 +1,171 @@
-#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
-#include <limits.h>
-#include "dinic.h"
+#include <stdint.h>
+#include "dinic_interne.h"
+
 // -----------------------------------------------------------------------------
-// Fonctions utilitaires génériques et file d'attente FIFO d'entiers
-//
-// - xmalloc(size)  : alloue 'size' octets ou termine le programme en cas d'échec.
-// - Queue          : structure pour gérer une file d'entiers.
-//   - queue_create : crée une file de capacité 'n'.
-//   - queue_empty  : teste si la file est vide.
-//   - queue_push   : ajoute un entier à la fin de la file.
-//   - queue_pop    : retire et renvoie l'entier en tête de la file.
-//   - queue_free   : libère la mémoire associée à la file.
+// Algorithme de Dinic : graphe de niveaux (BFS) et flot bloquant (DFS),
+// version classique et version par mise à l'échelle des capacités
 // -----------------------------------------------------------------------------
-static void *xmalloc(size_t size) {
-    void *p = malloc(size);
-    if (!p) {
-        fprintf(stderr, "Erreur d'allocation memoire\n");
-        exit(EXIT_FAILURE);
-    }
-    return p;
-}
-
-typedef struct {
-    int *data;
-    int head, tail, capacity;
-} Queue;
-
-static Queue *queue_create(int n) {
-    Queue *q = xmalloc(sizeof *q);
-    q->data     = xmalloc(n * sizeof *q->data);
-    q->head = q->tail = 0;
-    q->capacity = n;
-    return q;
-}
-
-static bool queue_empty(const Queue *q) {
-    return q->head == q->tail;
-}
-
-static void queue_push(Queue *q, int v) {
-    q->data[q->tail++] = v;
-}
-
-static int queue_pop(Queue *q) {
-    return q->data[q->head++];
-}
-
-static void queue_free(Queue *q) {
-    free(q->data);
-    free(q);
-}
-
-/***********************************************************************************************************/
-/* Action buildGraph :                                                                                     */
-/*   - lit un fichier DIMACS et construit le réseau initial                                               */
-/*   - paramètres : const char* filename (chemin du fichier DIMACS)                                       */
-/*   - retourne : Graphe* initialisé (flots à 0)                                                            */
-/* Fonctionnement :                                                                                        */
-/*   1. Lecture de la ligne 'p' pour obtenir nombre de sommets et d'arcs                                   */
-/*   2. Allocation du Graphe et initialisation des listes de successeurs                                   */
-/*   3. Parcours des lignes :                                                                             */
-/*      - 'n id s|t' pour identifier source et puits                                                       */
-/*      - 'a u v c' pour créer un Maillon (u->v) avec capacité c                                            */
-/*   4. Vérification que source et puits sont valides                                                       */
-/***********************************************************************************************************/
-Graphe* buildGraph(const char *filename) {
-    FILE *fp = fopen(filename, "r");
-    if (!fp) { perror("Ouverture fichier"); exit(EXIT_FAILURE); }
-
-    int n = 0, m = 0, src = -1, snk = -1;
-    char line[256];
-    (void)sscanf; // pour supprimer l'avertissement
-    while (fgets(line, sizeof(line), fp)) {
-        if (line[0] == 'c') continue;
-        if (line[0] == 'p') {
-            char tag[16];
-            (void)sscanf(line, "p %15s %d %d", tag, &n, &m);
-            break;
-        }
-    }
-    if (n <= 0) { fprintf(stderr, "DIMACS invalide: nb sommets\n"); exit(EXIT_FAILURE); }
-
-    Graphe *g = xmalloc(sizeof *g);
-    g->nbSommets = n + 1;
-    g->successeurs = xmalloc((n + 1) * sizeof *g->successeurs);
-    for (int i = 0; i <= n; i++) g->successeurs[i] = (ListeSucc){0};
-
-    rewind(fp);
-    while (fgets(line, sizeof(line), fp)) {
-        if (line[0] == 'c' || line[0] == 'p') continue;
-        if (line[0] == 'n') {
-            int id; char t;
-            if (sscanf(line, "n %d %c", &id, &t) == 2) {
-                if (t == 's') src = id;
-                else if (t == 't') snk = id;
-            }
-        } else if (line[0] == 'a') {
-            int u, v, c;
-            if (sscanf(line, "a %d %d %d", &u, &v, &c) == 3) {
-                Maillon *arc = xmalloc(sizeof *arc);
-                *arc = (Maillon){ .SommetDest = v, .capa = c, .flot = 0, .suivant = g->successeurs[u].tete };
-                g->successeurs[u].tete = arc;
-                g->successeurs[u].taille++;
-            }
-        }
-    }
-    fclose(fp);
-    if (src < 1 || src > n || snk < 1 || snk > n) { fprintf(stderr, "Source ou puits manquant\n"); exit(EXIT_FAILURE); }
-    g->source = src; g->puits = snk;
-    return g;
-}
-
-/***********************************************************************************************************/
-/* Action buildResidualGraph :                                                                            */
-/*   - construit le graphe résiduel à partir du réseau initial                                             */
-/*   - crée pour chaque arc (u->v) deux arcs : direct (c-f) et inverse (f)                                 */
-/*   - pas de pointeur reverse, l'arc inverse est cherché dynamiquement                                     */
-/*   - paramètres : const Graphe* g (réseau initial)                                                      */
-/*   - retourne : Graphe* résiduel                                                                         */
-/***********************************************************************************************************/
-Graphe* buildResidualGraph(const Graphe *g) {
-    int n = g->nbSommets;
-    Graphe *rg = xmalloc(sizeof *rg);
-    *rg = (Graphe){ .nbSommets = n, .successeurs = xmalloc(n * sizeof *rg->successeurs),
-                   .source = g->source, .puits = g->puits };
-    for (int i = 0; i < n; i++) rg->successeurs[i] = (ListeSucc){0};
-
-    for (int u = 1; u < n; u++) {
-        for (Maillon *e = g->successeurs[u].tete; e; e = e->suivant) {
-            int v = e->SommetDest;
-            int cd = e->capa - e->flot;
-            int cr = e->flot;
-            Maillon *ad = xmalloc(sizeof *ad);
-            *ad = (Maillon){ .SommetDest = v, .capa = cd, .flot = 0, .suivant = rg->successeurs[u].tete };
-            rg->successeurs[u].tete = ad;
-            rg->successeurs[u].taille++;
-            Maillon *ar = xmalloc(sizeof *ar);
-            *ar = (Maillon){ .SommetDest = u, .capa = cr, .flot = 0, .suivant = rg->successeurs[v].tete };
-            rg->successeurs[v].tete = ar;
-            rg->successeurs[v].taille++;
-        }
-    }
-    return rg;
-}
 
 /***********************************************************************************************************/
-/* Action shortestPath :                                                                                   */
-/*   - trouve un plus court chemin (l'exploration en largeur) de source à puits dans le graphe résiduel                         */
-/*   - paramètres : const Graphe* rg (graphe résiduel)                                                     */
-/*   - retourne : Chemin* (séquence de sommets) ou NULL si pas de chemin                                   */
+/* Action buildLevelGraph :                                                                                */
+/*   - BFS depuis la source sur les arcs résiduels de capacité >= delta (delta = 1 : tous les arcs > 0)    */
+/*   - niveau[v] = distance de la source à v, -1 si v n'est pas atteint                                    */
+/*   - l'exploration s'arrête dès que le niveau du puits est dépassé (arcs inutiles pour la phase)         */
+/*   - version séquentielle ; les moteurs utilisent construireNiveaux (bfs.c), qui donne les mêmes niveaux */
+/*   - paramètres : const Graphe* rg, Capacite delta,                                                      */
+/*                  int* niveau, int* file (tableaux de n cases fournis par l'appelant),                   */
+/*                  Statistiques* st (facultatif : arcs parcourus)                                         */
+/*   - retourne : true si le puits est atteint                                                             */
 /***********************************************************************************************************/
-Chemin* shortestPath(const Graphe *rg) {
+bool buildLevelGraph(const Graphe *rg, Capacite delta, int *niveau, int *file, Statistiques *st) {
     int n = rg->nbSommets;
-    bool *vis = xmalloc(n * sizeof *vis);
-    int *par = xmalloc(n * sizeof *par);
-    for (int i = 0; i < n; i++) vis[i] = false;
-
-    Queue *q = queue_create(n);
-    queue_push(q, rg->source);
-    vis[rg->source] = true;
-    par[rg->source] = -1;
-    bool found = false;
-    while (!queue_empty(q)) {
-        int u = queue_pop(q);
-        if (u == rg->puits) { found = true; break; }
-        for (Maillon *e = rg->successeurs[u].tete; e; e = e->suivant) {
-            int v = e->SommetDest;
-            if (!vis[v] && e->capa > 0) {
-                vis[v] = true;
-                par[v] = u;
-                queue_push(q, v);
+    int64_t arcs = 0;
+    for (int i = 0; i < n; i++) niveau[i] = -1;
+
+    int head = 0, tail = 0;
+    file[tail++] = rg->source;
+    niveau[rg->source] = 0;
+    while (head < tail) {
+        int u = file[head++];
+        if (niveau[rg->puits] >= 0 && niveau[u] >= niveau[rg->puits]) break;
+        arcs += rg->debut[u + 1] - rg->debut[u];
+        for (int e = rg->debut[u]; e < rg->debut[u + 1]; e++) {
+            int v = rg->SommetDest[e];
+            if (niveau[v] < 0 && rg->capa[e] >= delta) {
+                niveau[v] = niveau[u] + 1;
+                file[tail++] = v;
             }
         }
     }
-    queue_free(q);
-    if (!found) { free(vis); free(par); return NULL; }
-
-    int len = 0;
-    for (int v = rg->puits; v != -1; v = par[v]) len++;
-    Chemin *path = xmalloc(sizeof *path);
-    path->taille = len;
-    path->sommets = xmalloc(len * sizeof *path->sommets);
-    for (int idx = len - 1, v = rg->puits; v != -1; v = par[v], idx--) {
-        path->sommets[idx] = v;
-    }
-    free(vis);
-    free(par);
-    return path;
-}
-
-/***********************************************************************************************************/
-/* Action minCapacity :                                                                                    */
-/*   - calcule la capacité minimale des arcs le long d'un chemin                                            */
-/*   - paramètres : const Graphe* rg (graphe résiduel), const Chemin* path                                 */
-/*   - retourne : int (capacité minimale)                                                                  */
-/***********************************************************************************************************/
-int minCapacity(const Graphe *rg, const Chemin *path) {
-    int minC = INT_MAX;
-    for (int i = 0; i < path->taille - 1; i++) {
-        int u = path->sommets[i];
-        int v = path->sommets[i+1];
-        for (Maillon *e = rg->successeurs[u].tete; e; e = e->suivant) {
-            if (e->SommetDest == v && e->capa < minC) {
-                minC = e->capa;
+    if (st) st->arcsParcourus += arcs;
+    return niveau[rg->puits] >= 0;
+}
+
+/***********************************************************************************************************/
+/* Action blockingFlow :                                                                                   */
+/*   - DFS itératif dans le graphe de niveaux : on n'emprunte que les arcs (u->v) de capacité >= delta     */
+/*     avec niveau[v] == niveau[u] + 1                                                                     */
+/*   - courant[u] mémorise le prochain arc à essayer depuis u : un arc abandonné ne l'est qu'une fois      */
+/*     par phase, ce qui borne la phase à O(VE)                                                            */
+/*   - à chaque arrivée au puits on pousse le goulot sur la pile d'arcs puis on recule jusqu'au premier    */
+/*     arc devenu inutilisable (capacité < delta) ; la pile reste sinon en place                           */
+/*   - paramètres : Graphe* rg, Capacite delta, const int* niveau, int* courant, int* pile (n cases),      */
+/*                  Statistiques* st (facultatif : chemins, longueurs et arcs parcourus)                   */
+/*   - retourne : Capacite (flot poussé pendant la phase)                                                  */
+/***********************************************************************************************************/
+Capacite blockingFlow(Graphe *rg, Capacite delta, const int *niveau, int *courant, int *pile, Statistiques *st) {
+    Capacite total = 0;
+    int64_t chemins = 0, longueur = 0, arcs = 0;
+    int top = 0;
+    int u = rg->source;
+    for (;;) {
+        if (u == rg->puits) {
+            Capacite k = CAPACITE_MAX;
+            for (int i = 0; i < top; i++) {
+                if (rg->capa[pile[i]] < k) k = rg->capa[pile[i]];
             }
+            int retour = -1;
+            for (int i = 0; i < top; i++) {
+                rg->capa[pile[i]] -= k;
+                rg->capa[rg->inverse[pile[i]]] += k;
+                if (retour < 0 && rg->capa[pile[i]] < delta) retour = i;
+            }
+            total += k;
+            chemins++;
+            longueur += top;
+            top = retour;
+            u = (top == 0) ? rg->source : rg->SommetDest[pile[top - 1]];
+            continue;
         }
-    }
-    return minC;
-}
-
-/***********************************************************************************************************/
-/* Action updateResidualGraph :                                                                            */
-/*   - met à jour les capacités résiduelles selon l'augmentation k                                         */
-/*   - paramètres : Graphe* rg (graphe résiduel), const Chemin* path, int k (flot à ajouter)               */
-/***********************************************************************************************************/
-void updateResidualGraph(Graphe *rg, const Chemin *path, int k) {
-    for (int i = 0; i < path->taille - 1; i++) {
-        int u = path->sommets[i];
-        int v = path->sommets[i+1];
-        // arc direct
-        for (Maillon *e = rg->successeurs[u].tete; e; e = e->suivant) {
-            if (e->SommetDest == v) { e->capa -= k; break; }
-        }
-        // arc inverse
-        for (Maillon *e = rg->successeurs[v].tete; e; e = e->suivant) {
-            if (e->SommetDest == u) { e->capa += k; break; }
-        }
-    }
-}
 
-/***********************************************************************************************************/
-/* Action updateNetworkFlow :                                                                               */
-/*   - applique dans le réseau initial les flots calculés dans le graphe résiduel                            */
-/*   - paramètres : const Graphe* rg (graphe résiduel), Graphe* g (réseau initial)                         */
-/***********************************************************************************************************/
-void updateNetworkFlow(const Graphe *rg, Graphe *g) {
-    for (int u = 1; u < g->nbSommets; u++) {
-        for (Maillon *e = g->successeurs[u].tete; e; e = e->suivant) {
-            int init_capa = e->capa;
-            for (Maillon *r = rg->successeurs[u].tete; r; r = r->suivant) {
-                if (r->SommetDest == e->SommetDest) {
-                    e->flot = init_capa - r->capa;
-                    break;
-                }
-            }
+        int e = courant[u], fin = rg->debut[u + 1];
+        while (e < fin && !(rg->capa[e] >= delta && niveau[rg->SommetDest[e]] == niveau[u] + 1)) e++;
+        arcs += e - courant[u] + (e < fin);
+        courant[u] = e;
+        if (e < fin) {
+            pile[top++] = e;
+            u = rg->SommetDest[e];
+        } else {
+            // impasse : on recule et on abandonne l'arc qui y menait
+            if (top == 0) break;
+            top--;
+            u = (top == 0) ? rg->source : rg->SommetDest[pile[top - 1]];
+            courant[u]++;
         }
     }
-}
-
-/***********************************************************************************************************/
-/* Action ecrireResultat :                                                                                  */
-/*   - écrit le flot maximal et les flux des arcs dans un fichier texte "resultat.txt"                      */
-/*   - paramètres : const Graphe* res (réseau final), int flot_total (flot maximal)                         */
-/***********************************************************************************************************/
-void ecrireResultat(const Graphe* res, int flot_total) {
-    FILE* fout = fopen("resultat.txt", "w");
-    if (!fout) {
-        fprintf(stderr, "Erreur : impossible de créer le fichier resultat.txt\n");
-        return;
+    if (st) {
+        st->nbChemins += chemins;
+        st->longueurChemins += longueur;
+        st->arcsParcourus += arcs;
     }
-    fprintf(fout, "Flot maximal : %d\n", flot_total);
-    fprintf(fout, "\nFlux sur les arcs :\n");
-    for (int u = 1; u < res->nbSommets; u++) {
-        for (Maillon* a = res->successeurs[u].tete; a; a = a->suivant) {
-            fprintf(fout, "%d -> %d : flux %d / capacité %d\n",
-                    u, a->SommetDest, a->flot, a->capa);
+    return total;
+}
+
+/***********************************************************************************************************/
+/* Action dinicDelta :                                                                                     */
+/*   - prend les tableaux de travail dans le contexte puis, pour delta = deltaInitial, deltaInitial/2, ..., */
+/*     1, enchaîne les phases : un BFS parallèle (construireNiveaux) suivi d'un flot bloquant (blockingFlow) */
+/*     restreints aux arcs de capacité résiduelle >= delta ; chaque BFS et chaque flot bloquant est        */
+/*     chronométré dans les statistiques du contexte                                                       */
+/*   - retourne : DINIC_OK et *res = flot poussé, ou DINIC_ERREUR_MEMOIRE                                  */
+/***********************************************************************************************************/
+static DinicStatut dinicDelta(Contexte *ctx, Graphe *rg, Capacite deltaInitial, Capacite *res) {
+    size_t n = (size_t)rg->nbSommets;
+    int *niveau  = reserverTampon(ctx, T_NIVEAU, n * sizeof *niveau);
+    int *courant = reserverTampon(ctx, T_COURANT, n * sizeof *courant);
+    int *pile    = reserverTampon(ctx, T_PILE, n * sizeof *pile);
+    if (!niveau || !courant || !pile) return DINIC_ERREUR_MEMOIRE;
+
+    Statistiques *st = &ctx->stats;
+    Capacite flot = 0;
+    for (Capacite delta = deltaInitial; delta >= 1; delta /= 2) {
+        for (;;) {
+            double t0 = maintenant();
+            bool atteint;
+            if (construireNiveaux(ctx, rg, delta, niveau, &atteint) != DINIC_OK) return DINIC_ERREUR_MEMOIRE;
+            double t1 = maintenant();
+            st->nbBfs++;
+            st->tempsBfs += t1 - t0;
+            if (!atteint) break;
+            memcpy(courant, rg->debut, n * sizeof *courant);
+            flot += blockingFlow(rg, delta, niveau, courant, pile, st);
+            st->tempsAugmentation += maintenant() - t1;
         }
     }
-    fclose(fout);
-    printf("Résultat écrit dans le fichier resultat.txt\n");
+    *res = flot;
+    return DINIC_OK;
 }
 
 /***********************************************************************************************************/
-/* Action freeGraph/freePath :                                                                              */
-/*   - libère la mémoire allouée pour un Graphe ou un Chemin                                                */
+/* Action dinic :                                                                                          */
+/*   - enchaîne les phases (BFS puis flot bloquant) sur tous les arcs résiduels (delta = 1)                */
+/*   - au plus n phases, chacune en O(VE) : O(V²E) au total                                                */
+/*   - paramètres : Contexte* ctx, Graphe* rg (graphe résiduel), Capacite* flot (flot maximal)             */
+/*   - retourne : DINIC_OK ou DINIC_ERREUR_MEMOIRE                                                         */
 /***********************************************************************************************************/
-void freeGraph(Graphe *g) {
-    if (!g) return;
-    for (int u = 0; u < g->nbSommets; u++) {
-        Maillon *e = g->successeurs[u].tete;
-        while (e) { Maillon *n = e->suivant; free(e); e = n; }
-    }
-    free(g->successeurs);
-    free(g);
-}
-
-void freePath(Chemin *path) {
-    if (!path) return;
-    free(path->sommets);
-    free(path);
+DinicStatut dinic(Contexte *ctx, Graphe *rg, Capacite *flot) {
+    return dinicDelta(ctx, rg, 1, flot);
 }
 
 /***********************************************************************************************************/
-/* main :                                                                                                   */
-/*   - exécute l'algorithme de Dinic et écrit le résultat                                                   */
-/*   - paramètres : argc, argv (chemin du fichier DIMACS)                                                   */
+/* Action dinicScaling :                                                                                   */
+/*   - Dinic par mise à l'échelle des capacités : delta part de la plus grande puissance de 2 <= U         */
+/*     (U = capacité résiduelle maximale) et est divisé par 2 à chaque tour                                */
+/*   - à la fin d'un tour, la coupe restante est < 2m.delta : chaque tour ne fait que peu d'augmentations  */
+/*     et le nombre de tours est borné par log2(U) + 1                                                     */
+/*   - paramètres : Contexte* ctx, Graphe* rg (graphe résiduel), Capacite* flot (flot maximal)             */
+/*   - retourne : DINIC_OK ou DINIC_ERREUR_MEMOIRE                                                         */
 /***********************************************************************************************************/
-int main(int argc, char **argv) {
-    if (argc != 2) { fprintf(stderr, "Usage: %s <DIMACS>\n", argv[0]); return EXIT_FAILURE; }
-    Graphe *network = buildGraph(argv[1]);
-    Graphe *resGraph = buildResidualGraph(network);
-
-    int maxFlow = 0;
-    Chemin *path;
-    while ((path = shortestPath(resGraph))) {
-        int k = minCapacity(resGraph, path);
-        updateResidualGraph(resGraph, path, k);
-        updateNetworkFlow(resGraph, network);
-        maxFlow += k;
-        freePath(path);
+DinicStatut dinicScaling(Contexte *ctx, Graphe *rg, Capacite *flot) {
+    Capacite cmax = 0;
+    for (int e = 0; e < rg->nbArcs; e++) {
+        if (rg->capa[e] > cmax) cmax = rg->capa[e];
     }
-
-    ecrireResultat(network, maxFlow);
-    freeGraph(resGraph);
-    freeGraph(network);
-    return EXIT_SUCCESS;
+    Capacite delta = 1;
+    while (delta <= cmax / 2) delta *= 2;
+    return dinicDelta(ctx, rg, delta, flot);
 }
+
@@ -2,123 +2,455 @@
 #define DINIC_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// libdinic : calcul de flot maximal (Dinic, push-relabel) sur réseaux DIMACS
+//
+// Utilisation typique :
+//     Contexte *ctx = creerContexte();
+//     Graphe *g, *rg;
+//     Capacite flot;
+//     if (buildGraph(ctx, "reseau.max", &g) == DINIC_OK &&
+//         buildResidualGraph(ctx, g, &rg) == DINIC_OK &&
+//         resoudre(ctx, rg, ALGO_DINIC, &flot) == DINIC_OK) { ... }
+//     ... freeGraph(rg); freeGraph(g); ...
+//     libererContexte(ctx);
+//
+// Le contexte possède toutes les zones de travail des algorithmes : elles ne
+// sont agrandies que lorsqu'un graphe plus grand que les précédents est
+// résolu, si bien qu'un même contexte enchaîne des milliers de résolutions
+// sans allocation. Aucune fonction ne termine le programme : les erreurs sont
+// renvoyées sous forme de DinicStatut, le détail est donné par derniereErreur.
+// Un contexte ne doit être utilisé que par un thread à la fois.
+// -----------------------------------------------------------------------------
 
 // -----------------------------------------------------------------------------
 // Structures de données pour l'algorithme de Dinic
 // -----------------------------------------------------------------------------
 
-// Maillon de la liste chaînée d'arcs sortants
-// - SommetDest : numéro du sommet de destination
-// - capa       : capacité résiduelle de l'arc
-// - flot       : flot courant sur l'arc
-// - suivant    : pointeur vers le prochain maillon de la liste
-
-typedef struct maillon {
-    int SommetDest;
-    int capa;
-    int flot;
-    struct maillon *suivant;
-} Maillon;
-
-// Liste chaînée de maillons pour les successeurs d'un sommet
-// - tete   : premier maillon de la liste
-// - taille : nombre d'arcs sortants
-
-typedef struct listeSucc {
-    Maillon *tete;
-    int      taille;
-} ListeSucc;
-
-// Chemin de source à puits dans le graphe résiduel
-// - sommets : tableau dynamique d'indices de sommets
-// - taille  : nombre de sommets dans le chemin
-
-typedef struct chemin {
-    int *sommets;
-    int  taille;
-} Chemin;
-
-// Graphe orienté (réseau initial ou résiduel)
-// - nbSommets    : nombre total de sommets
-// - successeurs  : tableau de listes de successeurs
+// Capacités et flots sur 64 bits (capacités jusqu'à ~9.10^18)
+
+typedef int64_t Capacite;
+#define CAPACITE_MAX INT64_MAX
+
+// Graphe orienté au format CSR (compressed sparse row), réseau initial ou résiduel
+// Les arcs sortants de u occupent les indices [debut[u], debut[u+1]) des tableaux
+// d'arcs, rangés de façon contiguë par un tri par dénombrement sur l'origine.
+// - nbSommets    : nombre total de sommets (numérotés 1..n, la case 0 est inutilisée)
+// - nbArcs       : nombre d'arcs
+// - debut        : nbSommets + 1 cases, premier arc sortant de chaque sommet
+// - SommetDest   : sommet de destination de chaque arc
+// - capa         : capacité de l'arc (réseau initial) ou capacité résiduelle (graphe résiduel)
+// - flot         : flot courant sur l'arc (réseau initial uniquement, NULL sinon)
+// - inverse      : indice de l'arc inverse apparié (graphe résiduel uniquement, NULL sinon)
+// - arcResiduel  : indice de l'arc direct correspondant dans le graphe résiduel (réseau initial
+//                  uniquement, rempli par buildResidualGraph) ; distingue les arcs parallèles
 // - source, puits: indices de la source et du puits
+// - projection   : cache binaire projeté en mémoire dont debut, SommetDest et capa sont des
+//                  vues (lireGrapheBinaire), NULL si les tableaux ont été alloués
 
 typedef struct graphe {
-    int       nbSommets;
-    ListeSucc *successeurs;
-    int       source;
-    int       puits;
+    int  nbSommets;
+    int  nbArcs;
+    int *debut;
+    int *SommetDest;
+    Capacite *capa;
+    Capacite *flot;
+    int *inverse;
+    int *arcResiduel;
+    int  source;
+    int  puits;
+    void  *projection;
+    size_t tailleProjection;
 } Graphe;
 
+// Codes de retour des fonctions de la bibliothèque
+
+typedef enum {
+    DINIC_OK = 0,
+    DINIC_ERREUR_MEMOIRE,    // allocation impossible
+    DINIC_ERREUR_FICHIER,    // ouverture, projection ou écriture d'un fichier
+    DINIC_ERREUR_FORMAT,     // fichier DIMACS invalide
+    DINIC_ERREUR_PARAMETRE   // argument invalide (algorithme inconnu, graphe incohérent...)
+} DinicStatut;
+
+// Algorithmes de flot maximal disponibles
+
+typedef enum {
+    ALGO_DINIC,              // Dinic : BFS par phase + flot bloquant (dinicUnitaire si capacités unitaires)
+    ALGO_SCALING,            // Dinic par mise à l'échelle des capacités
+    ALGO_HIPR,               // push-relabel « highest label »
+    ALGO_PARALLELE,          // push-relabel multithread sans verrou
+    ALGO_BK                  // Boykov-Kolmogorov : arbres de recherche réutilisés (grilles)
+} Algorithme;
+
+// Formats du fichier résultat (ecrireResultat)
+
+typedef enum {
+    SORTIE_TEXTE,            // flot maximal puis une ligne par arc : "u -> v : flux f / capacité c"
+    SORTIE_BINAIRE,          // en-tête puis flux des arcs (Capacite) dans l'ordre CSR du réseau
+    SORTIE_COUPE             // flot maximal, sommets du côté source de la coupe minimale et arcs coupés
+} ModeSortie;
+
+// Modification de capacité pour le calcul incrémental
+// - arc      : indice de l'arc dans le réseau initial (voir trouverArc)
+// - capacite : nouvelle capacité (>= 0)
+
+typedef struct {
+    int      arc;
+    Capacite capacite;
+} ModifCapacite;
+
+// Arbre de Gomory-Hu (coupes minimales de toutes les paires d'un réseau non orienté)
+// - nbSommets  : comme le Graphe (sommets 1..nbSommets-1, racine 1)
+// - parent     : parent de chaque sommet (0 pour la racine et la case 0), parent[v] < v
+// - coupe      : coupe minimale entre v et parent[v]
+// - profondeur : distance à la racine (remontée des chemins par coupeMinimale)
+
+typedef struct {
+    int       nbSommets;
+    int      *parent;
+    Capacite *coupe;
+    int      *profondeur;
+} ArbreCoupes;
+
+// Grille implicite (segmentation d'images) : le voxel (x, y, z) a l'indice x + largeur.(y + hauteur.z) ;
+// ses arcs vers la source, le puits et ses voisins sont des tableaux denses, sans liste d'arcs
+// - largeur, hauteur, profondeur : dimensions (profondeur 1 pour une image 2D)
+// - connexite : 4 ou 8 (2D), 6 ou 26 (3D) ; c'est aussi le nombre K de voisins de chaque voxel
+// - source    : capacité source -> voxel ; puits : capacité voxel -> puits (une case par voxel)
+// - voisins   : capacité du voxel v vers son k-ième voisin (directionGrille) en case v.K + k,
+//               nulle pour un voisin hors de la grille
+
+#define GRILLE_MAX_VOISINS 26
+
+typedef struct {
+    int       largeur, hauteur, profondeur;
+    int       connexite;
+    Capacite *source, *puits;
+    Capacite *voisins;
+} Grille;
+
+// Statistiques cumulées d'un contexte (remises à zéro par remettreStatistiques)
+// - temps*            : secondes passées dans chaque étape
+//   - Chargement      : buildGraph / lireGrapheBinaire
+//   - Reduction       : reduireGraphe
+//   - Residuel        : buildResidualGraph
+//   - Resolution      : resoudre, modifierCapacites et gomoryHu (dont Bfs et Augmentation)
+//   - Bfs             : BFS de niveaux (Dinic) ou ré-étiquetages globaux (push-relabel)
+//   - Augmentation    : flots bloquants (Dinic) ou décharges (push-relabel)
+//     (pour gomoryHu, Bfs, Augmentation et les compteurs sont cumulés sur tous les threads)
+//   - Ecriture        : ecrireResultat
+// - nbBfs             : nombre de BFS (phases de Dinic ou ré-étiquetages globaux)
+// - nbChemins         : chemins augmentants ; longueurChemins : somme de leurs longueurs
+// - nbPoussees        : poussées du push-relabel ; nbReetiquetages : ré-étiquetages locaux
+// - arcsParcourus     : arcs examinés par les BFS, les DFS et les décharges
+// - memoirePicKo      : pic de mémoire résidente du processus (mis à jour par statistiques)
+
+typedef struct {
+    double  tempsChargement, tempsReduction, tempsResiduel, tempsResolution;
+    double  tempsBfs, tempsAugmentation, tempsEcriture;
+    int64_t nbBfs;
+    int64_t nbChemins, longueurChemins;
+    int64_t nbPoussees, nbReetiquetages;
+    int64_t arcsParcourus;
+    long    memoirePicKo;
+} Statistiques;
+
+// Réduction d'un réseau (structure opaque) : correspondance entre les arcs du
+// réseau réduit et ceux du réseau initial, pour y reporter les flots
+
+typedef struct reduction Reduction;
+
+// Contexte de résolution (structure opaque) : zones de travail réutilisables,
+// nombre de threads et message de la dernière erreur
+
+typedef struct contexte Contexte;
+
 // -----------------------------------------------------------------------------
 // Prototypes des fonctions
 // -----------------------------------------------------------------------------
 
+/***********************************************************************************************************/
+/* Action creerContexte / libererContexte :                                                                */
+/*   - crée un contexte vide (aucune zone de travail n'est allouée avant la première résolution)           */
+/*   - retourne    : Contexte* ou NULL si la mémoire manque                                                */
+/*   - libererContexte libère le contexte et toutes ses zones de travail                                   */
+/***********************************************************************************************************/
+Contexte* creerContexte(void);
+void libererContexte(Contexte *ctx);
+
+/***********************************************************************************************************/
+/* Action definirThreads :                                                                                 */
+/*   - fixe le nombre de threads du chargement et du push-relabel parallèle (0 : nombre de cœurs)          */
+/***********************************************************************************************************/
+void definirThreads(Contexte *ctx, int nbThreads);
+
+/***********************************************************************************************************/
+/* Action derniereErreur / texteStatut :                                                                   */
+/*   - derniereErreur : message détaillé de la dernière erreur du contexte ("" si aucune)                  */
+/*   - texteStatut    : libellé d'un code de retour                                                        */
+/***********************************************************************************************************/
+const char* derniereErreur(const Contexte *ctx);
+const char* texteStatut(DinicStatut statut);
+
+/***********************************************************************************************************/
+/* Action statistiques / remettreStatistiques :                                                            */
+/*   - statistiques : compteurs et chronomètres cumulés du contexte, pic mémoire mis à jour                */
+/*   - remettreStatistiques : remet tous les compteurs à zéro                                              */
+/***********************************************************************************************************/
+const Statistiques* statistiques(Contexte *ctx);
+void remettreStatistiques(Contexte *ctx);
+
 /***********************************************************************************************************/
 /* Action buildGraph :                                                                                     */
 /*   - lit un fichier DIMACS et construit le réseau initial                                               */
-/*   - paramètres : const char* filename                                                                 */
-/*   - retourne    : Graphe* avec flots initialisés à 0                                                   */
+/*   - paramètres : Contexte* ctx, const char* filename, Graphe** g (résultat)                             */
+/*   - retourne    : DINIC_OK et *g avec flots initialisés à 0, ou un code d'erreur (*g = NULL)            */
 /***********************************************************************************************************/
-Graphe* buildGraph(const char *filename);
+DinicStatut buildGraph(Contexte *ctx, const char *filename, Graphe **g);
+
+/***********************************************************************************************************/
+/* Action ecrireGrapheBinaire :                                                                            */
+/*   - enregistre le réseau initial dans un cache binaire versionné, tableaux CSR alignés                  */
+/*   - paramètres : Contexte* ctx, const Graphe* g, const char* chemin                                     */
+/*   - retourne    : DINIC_OK ou DINIC_ERREUR_FICHIER                                                      */
+/***********************************************************************************************************/
+DinicStatut ecrireGrapheBinaire(Contexte *ctx, const Graphe *g, const char *chemin);
+
+/***********************************************************************************************************/
+/* Action lireGrapheBinaire :                                                                              */
+/*   - charge un cache binaire sans analyse ni copie : les tableaux CSR sont projetés depuis le fichier    */
+/*   - paramètres : Contexte* ctx, const char* chemin, Graphe** g (résultat, flots à 0)                    */
+/*   - retourne    : DINIC_OK, DINIC_ERREUR_FICHIER, DINIC_ERREUR_FORMAT ou DINIC_ERREUR_MEMOIRE           */
+/***********************************************************************************************************/
+DinicStatut lireGrapheBinaire(Contexte *ctx, const char *chemin, Graphe **g);
+
+/***********************************************************************************************************/
+/* Action reduireGraphe :                                                                                  */
+/*   - réseau équivalent plus petit, à résoudre à la place de g : sommets inaccessibles depuis la source   */
+/*     ou ne menant pas au puits retirés, arcs parallèles fusionnés, chaînes u -> w -> v contractées       */
+/*   - paramètres : Contexte* ctx, const Graphe* g, Graphe** reduit (sommets renumérotés),                 */
+/*                  Reduction** r (correspondance pour restaurerFlots)                                     */
+/*   - retourne    : DINIC_OK ou DINIC_ERREUR_MEMOIRE (*reduit = NULL, *r = NULL)                          */
+/***********************************************************************************************************/
+DinicStatut reduireGraphe(Contexte *ctx, const Graphe *g, Graphe **reduit, Reduction **r);
+
+/***********************************************************************************************************/
+/* Action restaurerFlots / libererReduction :                                                              */
+/*   - restaurerFlots reporte les flots du réseau réduit (après updateNetworkFlow) sur chaque arc de g :   */
+/*     le flot obtenu est un flot maximal de g de même valeur                                              */
+/*   - libererReduction libère la correspondance (NULL accepté)                                            */
+/***********************************************************************************************************/
+void restaurerFlots(Reduction *r, const Graphe *reduit, Graphe *g);
+void libererReduction(Reduction *r);
 
 /***********************************************************************************************************/
 /* Action buildResidualGraph :                                                                            */
-/*   - construit le graphe résiduel à partir du réseau initial                                             */
-/*   - paramètres : const Graphe* g                                                                      */
-/*   - retourne    : Graphe* résiduel                                                                     */
+/*   - construit le graphe résiduel à partir du réseau initial et renseigne g->arcResiduel                 */
+/*   - paramètres : Contexte* ctx, Graphe* g, Graphe** rg (résultat)                                       */
+/*   - retourne    : DINIC_OK ou DINIC_ERREUR_MEMOIRE (*rg = NULL)                                         */
 /***********************************************************************************************************/
-Graphe* buildResidualGraph(const Graphe *g);
+DinicStatut buildResidualGraph(Contexte *ctx, Graphe *g, Graphe **rg);
 
 /***********************************************************************************************************/
-/* Action shortestPath :                                                                                   */
-/*   - recherche BFS du plus court chemin de source à puits                                                */
-/*   - paramètres : const Graphe* rg                                                                      */
-/*   - retourne    : Chemin* ou NULL si pas de chemin                                                      */
+/* Action resoudre :                                                                                       */
+/*   - calcule un flot maximal dans le graphe résiduel avec l'algorithme demandé                           */
+/*   - paramètres : Contexte* ctx, Graphe* rg (modifié en place), Algorithme algo, Capacite* flot          */
+/*   - retourne    : DINIC_OK, DINIC_ERREUR_MEMOIRE ou DINIC_ERREUR_PARAMETRE                              */
 /***********************************************************************************************************/
-Chemin* shortestPath(const Graphe *rg);
+DinicStatut resoudre(Contexte *ctx, Graphe *rg, Algorithme algo, Capacite *flot);
 
 /***********************************************************************************************************/
-/* Action minCapacity :                                                                                    */
-/*   - calcule la capacité minimale sur un chemin                                                          */
-/*   - paramètres : const Graphe* rg, const Chemin* chemin                                                */
-/*   - retourne    : int (capacité minimale)                                                              */
+/* Action creerGrille / libererGrille :                                                                    */
+/*   - creerGrille alloue une grille largeur x hauteur x profondeur de la connexité donnée, capacités 0    */
+/*   - libererGrille libère la grille (NULL accepté)                                                       */
+/*   - retourne    : DINIC_OK, DINIC_ERREUR_MEMOIRE ou DINIC_ERREUR_PARAMETRE (*g = NULL)                  */
 /***********************************************************************************************************/
-int minCapacity(const Graphe *rg, const Chemin *chemin);
+DinicStatut creerGrille(Contexte *ctx, int largeur, int hauteur, int profondeur, int connexite, Grille **g);
+void libererGrille(Grille *g);
 
 /***********************************************************************************************************/
-/* Action updateResidualGraph :                                                                            */
-/*   - met à jour les capacités résiduelles selon l'augmentation k                                          */
-/*   - paramètres : Graphe* rg, const Chemin* chemin, int k                                                 */
+/* Action directionGrille :                                                                                */
+/*   - rang k du voisin (x+dx, y+dy, z+dz) dans les arcs d'un voxel ; les directions opposées ont les      */
+/*     rangs k et K-1-k                                                                                    */
+/*   - retourne    : k, ou -1 si ce déplacement n'est pas un voisin pour la connexité de g                 */
 /***********************************************************************************************************/
-void updateResidualGraph(Graphe *rg, const Chemin *chemin, int k);
+int directionGrille(const Grille *g, int dx, int dy, int dz);
+
+/***********************************************************************************************************/
+/* Action lireGrille :                                                                                     */
+/*   - lit une grille implicite au format texte (lignes 'p grille', 't' et 'a', voir Readme)               */
+/*   - paramètres : Contexte* ctx, const char* chemin, Grille** g (résultat)                               */
+/*   - retourne    : DINIC_OK, DINIC_ERREUR_FICHIER, DINIC_ERREUR_FORMAT ou DINIC_ERREUR_MEMOIRE           */
+/***********************************************************************************************************/
+DinicStatut lireGrille(Contexte *ctx, const char *chemin, Grille **g);
+
+/***********************************************************************************************************/
+/* Action flotGrille :                                                                                     */
+/*   - flot maximal d'une grille par Boykov-Kolmogorov, sans construire de graphe ; les capacités de g     */
+/*     deviennent les capacités résiduelles                                                                */
+/*   - paramètres : Contexte* ctx, Grille* g, Capacite* flot,                                              */
+/*                  uint64_t* coupe (NULL, ou (nbVoxels + 63) / 64 mots : bit v à 1 si le voxel v est du   */
+/*                  côté source de la coupe minimale)                                                      */
+/*   - retourne    : DINIC_OK, DINIC_ERREUR_MEMOIRE ou DINIC_ERREUR_PARAMETRE                              */
+/***********************************************************************************************************/
+DinicStatut flotGrille(Contexte *ctx, Grille *g, Capacite *flot, uint64_t *coupe);
+
+/***********************************************************************************************************/
+/* Action ecrireCoupeGrille :                                                                              */
+/*   - écrit la coupe de flotGrille en image PBM binaire (P4, un bit par voxel, 1 = côté source) ; les     */
+/*     tranches z se suivent verticalement (largeur x hauteur.profondeur pixels)                           */
+/*   - retourne    : DINIC_OK ou DINIC_ERREUR_FICHIER                                                      */
+/***********************************************************************************************************/
+DinicStatut ecrireCoupeGrille(Contexte *ctx, const Grille *g, const uint64_t *coupe, const char *chemin);
+
+/***********************************************************************************************************/
+/* Action trouverArc :                                                                                     */
+/*   - paramètres : const Graphe* g (réseau initial), int u, int v                                         */
+/*   - retourne    : indice du premier arc u -> v, ou -1 s'il n'existe pas                                 */
+/***********************************************************************************************************/
+int trouverArc(const Graphe *g, int u, int v);
+
+/***********************************************************************************************************/
+/* Action modifierCapacites :                                                                              */
+/*   - démarrage à chaud : applique un lot de modifications de capacités au réseau g et au graphe          */
+/*     résiduel rg d'un calcul précédent, répare le flot des arcs devenus trop petits et reprend           */
+/*     l'augmentation ; le résultat est celui d'un calcul complet sur les nouvelles capacités              */
+/*   - paramètres : Contexte* ctx, Graphe* g, Graphe* rg, const ModifCapacite* modifs, int nbModifs,       */
+/*                  Algorithme algo, Capacite* flot (en entrée : flot courant, en sortie : nouveau flot)   */
+/*   - retourne    : DINIC_OK, DINIC_ERREUR_MEMOIRE ou DINIC_ERREUR_PARAMETRE (aucune modification faite)  */
+/***********************************************************************************************************/
+DinicStatut modifierCapacites(Contexte *ctx, Graphe *g, Graphe *rg, const ModifCapacite *modifs, int nbModifs,
+                              Algorithme algo, Capacite *flot);
+
+/***********************************************************************************************************/
+/* Action gomoryHu :                                                                                       */
+/*   - arbre de Gomory-Hu (algorithme de Gusfield) du réseau lu comme non orienté : chaque arc u v c est   */
+/*     une arête de capacité c ; les n-2 flots maximaux sont répartis sur les threads du contexte, chacun  */
+/*     avec sa propre copie des capacités résiduelles ; le sens des arcs et les flots de g sont ignorés    */
+/*   - paramètres : Contexte* ctx, Graphe* g, Algorithme algo (moteur de chaque flot), ArbreCoupes** a     */
+/*   - retourne    : DINIC_OK, DINIC_ERREUR_MEMOIRE ou DINIC_ERREUR_PARAMETRE (*a = NULL)                  */
+/***********************************************************************************************************/
+DinicStatut gomoryHu(Contexte *ctx, Graphe *g, Algorithme algo, ArbreCoupes **a);
+
+/***********************************************************************************************************/
+/* Action coupeMinimale :                                                                                  */
+/*   - coupe minimale entre u et v : plus petite coupe du chemin u - v de l'arbre, O(longueur du chemin)   */
+/*   - paramètres : const ArbreCoupes* a, int u, int v                                                     */
+/*   - retourne    : Capacite (CAPACITE_MAX si u == v, -1 si u ou v n'est pas un sommet)                   */
+/***********************************************************************************************************/
+Capacite coupeMinimale(const ArbreCoupes *a, int u, int v);
+
+/***********************************************************************************************************/
+/* Action ecrireArbreCoupes / libererArbreCoupes :                                                         */
+/*   - ecrireArbreCoupes écrit une arête de l'arbre par ligne ("<v> -> <parent> : coupe <c>") dans chemin  */
+/*   - libererArbreCoupes libère l'arbre (NULL accepté)                                                    */
+/*   - retourne    : DINIC_OK ou DINIC_ERREUR_FICHIER                                                      */
+/***********************************************************************************************************/
+DinicStatut ecrireArbreCoupes(Contexte *ctx, const ArbreCoupes *a, const char *chemin);
+void libererArbreCoupes(ArbreCoupes *a);
+
+/***********************************************************************************************************/
+/* Action buildLevelGraph :                                                                                */
+/*   - BFS unique d'une phase : calcule le niveau (distance à la source) de chaque sommet                  */
+/*   - seuls les arcs de capacité résiduelle >= delta sont empruntés (delta = 1 : Dinic classique)         */
+/*   - paramètres : const Graphe* rg, Capacite delta, int* niveau, int* file (n cases chacun),             */
+/*                  Statistiques* st (arcs parcourus ajoutés, NULL pour ne rien compter)                   */
+/*   - retourne    : true si le puits est atteignable                                                      */
+/***********************************************************************************************************/
+bool buildLevelGraph(const Graphe *rg, Capacite delta, int *niveau, int *file, Statistiques *st);
+
+/***********************************************************************************************************/
+/* Action blockingFlow :                                                                                   */
+/*   - calcule un flot bloquant dans le graphe de niveaux (DFS avec pointeurs d'arc courant)               */
+/*   - paramètres : Graphe* rg, Capacite delta, const int* niveau, int* courant, int* pile (n cases),      */
+/*                  Statistiques* st (chemins et arcs parcourus ajoutés, NULL pour ne rien compter)        */
+/*   - retourne    : Capacite (flot poussé pendant la phase)                                               */
+/***********************************************************************************************************/
+Capacite blockingFlow(Graphe *rg, Capacite delta, const int *niveau, int *courant, int *pile, Statistiques *st);
+
+/***********************************************************************************************************/
+/* Action dinic :                                                                                          */
+/*   - enchaîne les phases (buildLevelGraph puis blockingFlow) jusqu'à ce que le puits soit inaccessible   */
+/*   - paramètres : Contexte* ctx, Graphe* rg (graphe résiduel, modifié en place), Capacite* flot          */
+/*   - retourne    : DINIC_OK ou DINIC_ERREUR_MEMOIRE                                                      */
+/***********************************************************************************************************/
+DinicStatut dinic(Contexte *ctx, Graphe *rg, Capacite *flot);
+
+/***********************************************************************************************************/
+/* Action dinicScaling :                                                                                   */
+/*   - Dinic par mise à l'échelle des capacités : phases restreintes aux arcs de capacité >= delta,        */
+/*     delta divisé par 2 à chaque tour (au plus log2(U) + 1 tours)                                        */
+/*   - paramètres : Contexte* ctx, Graphe* rg (graphe résiduel, modifié en place), Capacite* flot          */
+/*   - retourne    : DINIC_OK ou DINIC_ERREUR_MEMOIRE                                                      */
+/***********************************************************************************************************/
+DinicStatut dinicScaling(Contexte *ctx, Graphe *rg, Capacite *flot);
+
+/***********************************************************************************************************/
+/* Action dinicUnitaire :                                                                                  */
+/*   - flot maximal d'un réseau dont chaque paire d'arcs résiduels a une capacité totale de 0 ou 1 :       */
+/*     Hopcroft-Karp si les arcs forment un couplage biparti (source -> G -> D -> puits), sinon Dinic      */
+/*     sur un état résiduel d'un bit par arc ; O(E.sqrt(V)) sur un réseau unitaire simple                  */
+/*   - choisi automatiquement par resoudre pour ALGO_DINIC et ALGO_SCALING                                 */
+/*   - paramètres : Contexte* ctx, Graphe* rg (graphe résiduel, modifié en place), Capacite* flot          */
+/*   - retourne    : DINIC_OK, DINIC_ERREUR_MEMOIRE ou DINIC_ERREUR_PARAMETRE (capacités non unitaires)    */
+/***********************************************************************************************************/
+DinicStatut dinicUnitaire(Contexte *ctx, Graphe *rg, Capacite *flot);
+
+/***********************************************************************************************************/
+/* Action pushRelabel :                                                                                    */
+/*   - flot maximal par push-relabel « highest label » (ré-étiquetage global depuis le puits et trou)      */
+/*   - paramètres : Contexte* ctx, Graphe* rg (graphe résiduel, modifié en place), Capacite* flot          */
+/*   - retourne    : DINIC_OK ou DINIC_ERREUR_MEMOIRE                                                      */
+/***********************************************************************************************************/
+DinicStatut pushRelabel(Contexte *ctx, Graphe *rg, Capacite *flot);
+
+/***********************************************************************************************************/
+/* Action pushRelabelParallele :                                                                           */
+/*   - push-relabel multithread sans verrou (excédents et capacités mis à jour par opérations atomiques)   */
+/*   - le nombre de threads est celui du contexte (definirThreads)                                         */
+/*   - paramètres : Contexte* ctx, Graphe* rg (graphe résiduel, modifié en place), Capacite* flot          */
+/*   - retourne    : DINIC_OK ou DINIC_ERREUR_MEMOIRE                                                      */
+/***********************************************************************************************************/
+DinicStatut pushRelabelParallele(Contexte *ctx, Graphe *rg, Capacite *flot);
+
+/***********************************************************************************************************/
+/* Action boykovKolmogorov :                                                                               */
+/*   - flot maximal par Boykov-Kolmogorov : arbres de recherche depuis la source et le puits, conservés    */
+/*     d'une augmentation à l'autre (adoption des orphelins) ; adapté aux grilles de segmentation          */
+/*   - paramètres : Contexte* ctx, Graphe* rg (graphe résiduel, modifié en place), Capacite* flot          */
+/*   - retourne    : DINIC_OK ou DINIC_ERREUR_MEMOIRE                                                      */
+/***********************************************************************************************************/
+DinicStatut boykovKolmogorov(Contexte *ctx, Graphe *rg, Capacite *flot);
 
 /***********************************************************************************************************/
 /* Action updateNetworkFlow :                                                                               */
-/*   - applique les flots du graphe résiduel dans le réseau initial                                        */
+/*   - applique les flots du graphe résiduel dans le réseau initial, en une passe O(E) à la fin du calcul  */
 /*   - paramètres : const Graphe* rg, Graphe* g                                                            */
 /***********************************************************************************************************/
 void updateNetworkFlow(const Graphe *rg, Graphe *g);
 
 /***********************************************************************************************************/
 /* Action ecrireResultat :                                                                                  */
-/*   - écrit le flot maximal et les flux des arcs dans "resultat.txt"                                      */
-/*   - paramètres : const Graphe* res, int flot_total                                                       */
+/*   - écrit le flot maximal dans 'chemin' et, selon 'mode', les flux des arcs (texte ou binaire) ou la    */
+/*     coupe minimale (sommets accessibles depuis la source dans le résiduel du flot final)                */
+/*   - format binaire : en-tête "DINICFLO" (version, ordre des octets, sommets, arcs, source, puits, flot  */
+/*     maximal) puis nbArcs flux aligné sur 64 octets, arcs dans l'ordre du cache de ecrireGrapheBinaire   */
+/*   - paramètres : Contexte* ctx, const Graphe* res (flots reportés par updateNetworkFlow),               */
+/*                  Capacite flot_total, const char* chemin, ModeSortie mode                               */
+/*   - retourne    : DINIC_OK, DINIC_ERREUR_FICHIER, DINIC_ERREUR_MEMOIRE ou DINIC_ERREUR_PARAMETRE        */
 /***********************************************************************************************************/
-void ecrireResultat(const Graphe *res, int flot_total);
+DinicStatut ecrireResultat(Contexte *ctx, const Graphe *res, Capacite flot_total, const char *chemin,
+                           ModeSortie mode);
 
 /***********************************************************************************************************/
 /* Action freeGraph :                                                                                       */
-/*   - libère la mémoire d'un Graphe                                                                        */
+/*   - libère la mémoire d'un Graphe (et sa projection s'il vient d'un cache binaire)                      */
 /*   - paramètres : Graphe* g                                                                              */
 /***********************************************************************************************************/
 void freeGraph(Graphe *g);
 
-/***********************************************************************************************************/
-/* Action freePath :                                                                                        */
-/*   - libère la mémoire d'un Chemin                                                                        */
-/*   - paramètres : Chemin* chemin                                                                          */
-/***********************************************************************************************************/
-void freePath(Chemin *chemin);
-
 #endif // DINIC_H
@@ -0,0 +1,135 @@
+#ifndef DINIC_INTERNE_H
+#define DINIC_INTERNE_H
+
+#include <stddef.h>
+#include "dinic.h"
+
+// -----------------------------------------------------------------------------
+// Déclarations internes à libdinic (non installées avec dinic.h)
+// -----------------------------------------------------------------------------
+
+// Zone de travail réutilisable d'un contexte : agrandie à la demande, jamais réduite
+// - donnees : bloc alloué
+// - taille  : taille du bloc en octets
+
+typedef struct {
+    void  *donnees;
+    size_t taille;
+} Tampon;
+
+// Identifiants des zones de travail du contexte
+
+enum {
+    T_NIVEAU, T_FILE, T_COURANT, T_PILE,          // Dinic (n cases)
+    T_VISITE, T_BITS_FRONTIERE,                   // BFS parallèle (n bits)
+    T_D, T_EXCEDENT,                              // push-relabel (n cases)
+    T_ACTIF_TETE, T_ACTIF_SUIV,
+    T_TOUS_TETE, T_TOUS_SUIV, T_TOUS_PREC,
+    T_EN_FILE, T_FILE_TOUR0, T_FILE_TOUR1,        // push-relabel parallèle (n cases)
+    T_FRONTIERE0, T_FRONTIERE1,
+    T_COTE, T_ARC_EXTERNE, T_PARTENAIRE,          // réseaux unitaires (n cases)
+    T_PILE_ARCS, T_BITS_RESIDUEL,                 // (n cases, m bits)
+    T_PARENT, T_ARBRE, T_MARQUE, T_DISTANCE,      // Boykov-Kolmogorov (n cases)
+    T_ACTIFS, T_ORPHELINS, T_TERMINAL,
+    T_CAPA_SOURCE, T_CAPA_PUITS, T_SAUVEGARDE,    // (n cases, arcs de la source et du puits)
+    T_POSITION,                                   // tri par dénombrement (n cases)
+    T_ENTRANTS, T_ECRITURE,                       // écriture du résultat (m cases, bloc de sortie)
+    T_ORIGINE, T_DEST, T_CAPA,                    // chargement DIMACS (m cases)
+    NB_TAMPONS
+};
+
+// Contexte de résolution
+// - nbThreads : nombre de threads demandé (0 : nombre de cœurs)
+// - erreur    : message de la dernière erreur
+// - tampons   : zones de travail
+// - stats     : statistiques cumulées
+
+#define TAILLE_MESSAGE_ERREUR 2048
+
+struct contexte {
+    int    nbThreads;
+    char   erreur[TAILLE_MESSAGE_ERREUR];
+    Tampon tampons[NB_TAMPONS];
+    Statistiques stats;
+};
+
+/***********************************************************************************************************/
+/* Action reserverTampon :                                                                                 */
+/*   - renvoie la zone de travail 'id' du contexte, agrandie à au moins 'octets' octets si nécessaire      */
+/*   - retourne : pointeur vers la zone, ou NULL (message d'erreur fixé) si la mémoire manque              */
+/***********************************************************************************************************/
+void* reserverTampon(Contexte *ctx, int id, size_t octets);
+
+/***********************************************************************************************************/
+/* Action fixerErreur / ajouterErreur :                                                                    */
+/*   - fixerErreur remplace le message du contexte (format printf) et renvoie 'statut'                     */
+/*   - ajouterErreur ajoute une ligne au message courant                                                   */
+/***********************************************************************************************************/
+DinicStatut fixerErreur(Contexte *ctx, DinicStatut statut, const char *format, ...);
+void ajouterErreur(Contexte *ctx, const char *format, ...);
+
+/***********************************************************************************************************/
+/* Action nombreThreads :                                                                                  */
+/*   - nombre de threads à utiliser (valeur du contexte, ou nombre de cœurs si elle vaut 0)                */
+/***********************************************************************************************************/
+int nombreThreads(const Contexte *ctx);
+
+/***********************************************************************************************************/
+/* Action maintenant :                                                                                     */
+/*   - horloge monotone en secondes, pour les chronomètres des statistiques                                */
+/***********************************************************************************************************/
+double maintenant(void);
+
+/***********************************************************************************************************/
+/* Action construireNiveaux :                                                                              */
+/*   - graphe de niveaux de buildLevelGraph calculé par un BFS parallèle à direction optimisée (bfs.c),    */
+/*     utilisable par tout moteur à chemins augmentants                                                    */
+/*   - retourne : DINIC_OK (*atteint : puits atteint) ou DINIC_ERREUR_MEMOIRE                              */
+/***********************************************************************************************************/
+DinicStatut construireNiveaux(Contexte *ctx, const Graphe *rg, Capacite delta, int *niveau, bool *atteint);
+
+/***********************************************************************************************************/
+/* Action construireNiveauxBits :                                                                          */
+/*   - construireNiveaux sur un résiduel tenu en bits (arc e utilisable si le bit e de libres est à 1)     */
+/***********************************************************************************************************/
+DinicStatut construireNiveauxBits(Contexte *ctx, const Graphe *rg, const uint64_t *libres, int *niveau, bool *atteint);
+
+/***********************************************************************************************************/
+/* Action estUnitaire / flotUnitaire :                                                                     */
+/*   - estUnitaire : vrai si le graphe résiduel relève de dinicUnitaire (unitaire.c) ; resoudre y aiguille */
+/*     alors Dinic et Dinic par mise à l'échelle                                                           */
+/*   - flotUnitaire : dinicUnitaire sans la vérification de estUnitaire                                    */
+/***********************************************************************************************************/
+bool estUnitaire(const Graphe *rg);
+DinicStatut flotUnitaire(Contexte *ctx, Graphe *rg, Capacite *flot);
+
+/***********************************************************************************************************/
+/* Action directionsGrille :                                                                               */
+/*   - déplacements (dx, dy, dz) des voisins d'une connexité, dans l'ordre lexicographique de (dz, dy, dx) */
+/*     (la direction opposée à k est donc K-1-k)                                                           */
+/*   - retourne : K, ou 0 si la connexité n'est pas 4, 8, 6 ou 26                                          */
+/***********************************************************************************************************/
+int directionsGrille(int connexite, int directions[GRILLE_MAX_VOISINS][3]);
+
+/***********************************************************************************************************/
+/* Action controlerGrille :                                                                                */
+/*   - dimensions et connexité acceptées par creerGrille et flotGrille                                     */
+/*   - retourne : DINIC_OK ou DINIC_ERREUR_PARAMETRE (message fixé)                                        */
+/***********************************************************************************************************/
+DinicStatut controlerGrille(Contexte *ctx, int largeur, int hauteur, int profondeur, int connexite);
+
+/***********************************************************************************************************/
+/* Action ecrireFlotsBinaire :                                                                             */
+/*   - SORTIE_BINAIRE de ecrireResultat : en-tête puis flux des arcs dans l'ordre CSR du réseau (binaire.c) */
+/***********************************************************************************************************/
+DinicStatut ecrireFlotsBinaire(Contexte *ctx, const Graphe *g, Capacite flot_total, const char *chemin);
+
+/***********************************************************************************************************/
+/* Action allocGraph / prefixSum :                                                                         */
+/*   - allocGraph : alloue un Graphe CSR vide (NULL si la mémoire manque)                                  */
+/*   - prefixSum  : transforme des degrés en indices de début CSR                                          */
+/***********************************************************************************************************/
+Graphe* allocGraph(int nbSommets, int nbArcs, bool residuel);
+void prefixSum(int *debut, int n);
+
+#endif // DINIC_INTERNE_H
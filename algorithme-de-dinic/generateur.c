@@ -0,0 +1,233 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+// -----------------------------------------------------------------------------
+// Générateur de réseaux DIMACS pour les mesures de performance
+//
+// UTILISATION : ./generateur <famille> <taille> [graine] > reseau.max
+//   - rmf     : réseau en couches de Goldfarb et Grigoriadis (genrmf), taille
+//               cadres de taille x taille sommets ; arcs internes aux cadres de
+//               grande capacité, arcs entre cadres aléatoires dans [1, 1000]
+//   - grille  : grille taille x taille, arcs vers les 4 voisins, source reliée
+//               à la première colonne et dernière colonne reliée au puits
+//   - ak      : réseau de type AK (Cherkassky et Goldberg) de paramètre taille :
+//               une chaîne qui impose ~taille phases à Dinic et une chaîne à
+//               capacités décroissantes qui multiplie les ré-étiquetages
+//   - biparti : couplage biparti, taille sommets de chaque côté, 8 arcs
+//               aléatoires de capacité 1 par sommet gauche
+//   - large   : graphe aléatoire de taille sommets et 8 x taille arcs dont les
+//               capacités sont réparties sur 40 ordres de grandeur (2^0..2^40)
+//   - segmentation : image taille x taille bruitée à segmenter, 4 voisins par
+//               pixel, au format grille de dinic --grille (et non DIMACS)
+//   - volume  : volume taille x taille x taille, 6 voisins par voxel, même format
+// La graine (1 par défaut) fixe entièrement le réseau : même famille, même
+// taille et même graine donnent le même fichier sur toute machine.
+// -----------------------------------------------------------------------------
+
+static uint64_t etat;
+
+// splitmix64 : générateur reproductible indépendant de la bibliothèque C
+static uint64_t aleatoire(void) {
+    uint64_t z = (etat += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// entier uniforme dans [a, b]
+static int64_t entre(int64_t a, int64_t b) {
+    return a + (int64_t)(aleatoire() % (uint64_t)(b - a + 1));
+}
+
+static void entete(const char *famille, long taille, long n, long m, long s, long t) {
+    printf("c %s taille %ld\np max %ld %ld\nn %ld s\nn %ld t\n", famille, taille, n, m, s, t);
+}
+
+static void arc(long u, long v, int64_t c) {
+    printf("a %ld %ld %" PRId64 "\n", u, v, c);
+}
+
+/***********************************************************************************************************/
+/* Action genererRmf :                                                                                     */
+/*   - a = b = taille : b cadres de a x a sommets, le sommet (x, y) du cadre k est a*a*k + a*y + x + 1     */
+/*   - chaque cadre est une grille aux arcs de capacité 1000*a*a ; chaque sommet du cadre k est relié au   */
+/*     sommet d'une permutation aléatoire du cadre k+1 (capacité dans [1, 1000])                           */
+/***********************************************************************************************************/
+static void genererRmf(long a) {
+    long aa = a * a, b = a, n = aa * b;
+    long m = b * 4 * a * (a - 1) + (b - 1) * aa;
+    entete("rmf", a, n, m, 1, n);
+    long *perm = malloc((size_t)aa * sizeof *perm);
+    if (!perm) { perror("malloc"); exit(EXIT_FAILURE); }
+    for (long k = 0; k < b; k++) {
+        long base = aa * k + 1;
+        for (long y = 0; y < a; y++) {
+            for (long x = 0; x < a; x++) {
+                long v = base + a * y + x;
+                if (x > 0)     arc(v, v - 1, 1000 * aa);
+                if (x < a - 1) arc(v, v + 1, 1000 * aa);
+                if (y > 0)     arc(v, v - a, 1000 * aa);
+                if (y < a - 1) arc(v, v + a, 1000 * aa);
+            }
+        }
+        if (k == b - 1) break;
+        for (long i = 0; i < aa; i++) perm[i] = i;
+        for (long i = aa - 1; i > 0; i--) {
+            long j = entre(0, i), tmp = perm[i];
+            perm[i] = perm[j];
+            perm[j] = tmp;
+        }
+        for (long i = 0; i < aa; i++) arc(base + i, base + aa + perm[i], entre(1, 1000));
+    }
+    free(perm);
+}
+
+/***********************************************************************************************************/
+/* Action genererGrille :                                                                                  */
+/*   - sommets 1..L*L de la grille (ligne par ligne), source L*L+1, puits L*L+2                            */
+/*   - capacités aléatoires dans [1, 100] entre voisins, 100*L depuis la source et vers le puits           */
+/***********************************************************************************************************/
+static void genererGrille(long L) {
+    long n = L * L + 2, s = L * L + 1, t = L * L + 2;
+    long m = 4 * L * (L - 1) + 2 * L;
+    entete("grille", L, n, m, s, t);
+    for (long y = 0; y < L; y++) {
+        arc(s, y * L + 1, 100 * L);
+        for (long x = 0; x < L; x++) {
+            long v = y * L + x + 1;
+            if (x > 0)     arc(v, v - 1, entre(1, 100));
+            if (x < L - 1) arc(v, v + 1, entre(1, 100));
+            if (y > 0)     arc(v, v - L, entre(1, 100));
+            if (y < L - 1) arc(v, v + L, entre(1, 100));
+        }
+        arc(y * L + L, t, 100 * L);
+    }
+}
+
+/***********************************************************************************************************/
+/* Action genererAk :                                                                                      */
+/*   - source 1, puits 2, chaîne p_1..p_k (sommets 3..k+2) : p_i -> p_i+1 de capacité k et p_i -> puits    */
+/*     de capacité 1 ; le i-ème chemin le plus court passe par p_i, d'où k phases de Dinic                 */
+/*   - chaîne q_1..q_k (sommets k+3..2k+2) à capacités décroissantes k-i, chaque q_i relié à x (2k+3) par  */
+/*     un arc de capacité 1, x -> puits de capacité k : l'excédent redescend la chaîne par paliers         */
+/*   - aucune graine : le réseau est déterministe                                                          */
+/***********************************************************************************************************/
+static void genererAk(long k) {
+    long n = 2 * k + 3, s = 1, t = 2, x = 2 * k + 3;
+    long m = 4 * k + 1;
+    entete("ak", k, n, m, s, t);
+    arc(s, 3, k);
+    for (long i = 1; i <= k; i++) {
+        long p = i + 2;
+        if (i < k) arc(p, p + 1, k);
+        arc(p, t, 1);
+    }
+    arc(s, k + 3, k);
+    for (long i = 1; i <= k; i++) {
+        long q = k + 2 + i;
+        if (i < k) arc(q, q + 1, k - i);
+        arc(q, x, 1);
+    }
+    arc(x, t, k);
+}
+
+/***********************************************************************************************************/
+/* Action genererBiparti :                                                                                 */
+/*   - source 1, gauche 2..N+1, droite N+2..2N+1, puits 2N+2 ; toutes les capacités valent 1               */
+/***********************************************************************************************************/
+static void genererBiparti(long N) {
+    const int degre = 8;
+    long n = 2 * N + 2, s = 1, t = 2 * N + 2;
+    entete("biparti", N, n, 2 * N + degre * N, s, t);
+    for (long i = 0; i < N; i++) arc(s, 2 + i, 1);
+    for (long i = 0; i < N; i++) {
+        for (int d = 0; d < degre; d++) arc(2 + i, N + 2 + entre(0, N - 1), 1);
+    }
+    for (long i = 0; i < N; i++) arc(N + 2 + i, t, 1);
+}
+
+/***********************************************************************************************************/
+/* Action genererLarge :                                                                                   */
+/*   - arcs aléatoires u -> v (u != v) de capacité 2^e + r, e uniforme dans [0, 40]                        */
+/*   - une chaîne 1 -> 2 -> ... -> N de capacité aléatoire garantit que le puits N est atteignable         */
+/***********************************************************************************************************/
+static void genererLarge(long N) {
+    long m = 8 * N;
+    entete("large", N, N, m, 1, N);
+    for (long i = 0; i < m; i++) {
+        long u, v;
+        if (i < N - 1) { u = i + 1; v = i + 2; }
+        else {
+            u = entre(1, N);
+            do v = entre(1, N); while (v == u);
+        }
+        int e = (int)entre(0, 40);
+        arc(u, v, ((int64_t)1 << e) + entre(0, ((int64_t)1 << e) - 1));
+    }
+}
+
+/***********************************************************************************************************/
+/* Action genererImage :                                                                                   */
+/*   - intensité 170 dans un disque (une boule en 3D) de rayon L/3 centré, 80 ailleurs, bruit dans         */
+/*     [-60, 60] ; capacité source |I - 80| et puits |I - 170| (coût de l'étiquette opposée)               */
+/*   - arcs vers les voisins de la connexité : 1 + 100 / (1 + (I_u - I_v)^2 / 100), faible sur un contour  */
+/***********************************************************************************************************/
+static void genererImage(const char *famille, long L, long P, int connexite) {
+    long n = L * L * P;
+    unsigned char *intensite = malloc((size_t)n);
+    if (!intensite) { perror("malloc"); exit(EXIT_FAILURE); }
+    printf("c %s taille %ld\np grille %ld %ld %ld %d\n", famille, L, L, L, P, connexite);
+    double centre = (L - 1) / 2.0, centreZ = (P - 1) / 2.0, rayon = L / 3.0;
+    for (long v = 0; v < n; v++) {
+        long x = v % L, y = v / L % L, z = v / (L * L);
+        double dx = x - centre, dy = y - centre, dz = (P > 1) ? z - centreZ : 0;
+        int base = (dx * dx + dy * dy + dz * dz <= rayon * rayon) ? 170 : 80;
+        intensite[v] = (unsigned char)(base + entre(-60, 60));
+        int i = intensite[v];
+        printf("t %ld %ld %ld %d %d\n", x, y, z, abs(i - 80), abs(i - 170));
+    }
+    for (long v = 0; v < n; v++) {
+        long x = v % L, y = v / L % L, z = v / (L * L);
+        for (int dz = -1; dz <= 1; dz++) {
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    if (abs(dx) + abs(dy) + abs(dz) != 1 || (connexite == 4 && dz != 0)) continue;
+                    long xv = x + dx, yv = y + dy, zv = z + dz;
+                    if (xv < 0 || xv >= L || yv < 0 || yv >= L || zv < 0 || zv >= P) continue;
+                    int d = intensite[v] - intensite[xv + L * (yv + L * zv)];
+                    printf("a %ld %ld %ld %d %d %d %d\n", x, y, z, dx, dy, dz, 1 + 10000 / (100 + d * d));
+                }
+            }
+        }
+    }
+    free(intensite);
+}
+
+static void genererSegmentation(long L) {
+    genererImage("segmentation", L, 1, 4);
+}
+
+static void genererVolume(long L) {
+    genererImage("volume", L, L, 6);
+}
+
+int main(int argc, char **argv) {
+    static const struct { const char *nom; void (*generer)(long); long min; } familles[] = {
+        { "rmf", genererRmf, 2 }, { "grille", genererGrille, 2 }, { "ak", genererAk, 2 },
+        { "biparti", genererBiparti, 1 }, { "large", genererLarge, 2 },
+        { "segmentation", genererSegmentation, 1 }, { "volume", genererVolume, 1 },
+    };
+    long taille = (argc >= 3) ? strtol(argv[2], NULL, 10) : 0;
+    etat = (argc >= 4) ? strtoull(argv[3], NULL, 10) : 1;
+    for (size_t i = 0; argc >= 3 && i < sizeof familles / sizeof familles[0]; i++) {
+        if (strcmp(argv[1], familles[i].nom) == 0 && taille >= familles[i].min) {
+            familles[i].generer(taille);
+            return fflush(stdout) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+    fprintf(stderr, "Usage: %s <rmf|grille|ak|biparti|large|segmentation|volume> <taille> [graine]\n", argv[0]);
+    return EXIT_FAILURE;
+}
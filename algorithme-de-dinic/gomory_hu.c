@@ -0,0 +1,318 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <errno.h>
+#include <pthread.h>
+#include "dinic_interne.h"
+
+// -----------------------------------------------------------------------------
+// Arbre de Gomory-Hu d'un réseau non orienté (algorithme de Gusfield)
+//
+// Chaque arc u v c du fichier est une arête de capacité c dans les deux sens.
+// Tous les sommets ont d'abord le sommet 1 pour parent ; pour i = 2..n-1, on
+// calcule une coupe minimale entre i et parent[i], puis les sommets j > i du
+// côté de i qui avaient le même parent sont rattachés à i. La coupe minimale
+// entre u et v est la plus petite coupe du chemin u - v de l'arbre.
+//
+// Les n-2 coupes ne sont pas indépendantes : celle de i dépend de parent[i],
+// qui n'est définitif qu'une fois les coupes 2..i-1 appliquées. Les threads
+// calculent donc les coupes par anticipation, avec le parent connu quand ils
+// les commencent (au plus GH_AVANCE coupes d'avance par thread), et elles sont
+// appliquées dans l'ordre des sommets ; une coupe dont le parent a changé
+// entre-temps est recalculée. Chaque thread a son propre contexte et sa copie
+// des capacités résiduelles ; la topologie du graphe résiduel est partagée.
+// -----------------------------------------------------------------------------
+#define GH_MAX_THREADS 64
+#define GH_AVANCE      2
+
+// Coupe calculée en attente d'application
+// - cible  : parent[i] au début du calcul
+// - valeur : capacité de la coupe
+// - cote   : bitmap des sommets du côté de i (accessibles depuis i dans le résiduel final)
+
+typedef struct {
+    int       cible;
+    Capacite  valeur;
+    uint64_t *cote;
+    bool      pret;
+} CoupeCalculee;
+
+typedef struct {
+    const Graphe  *rg;              // graphe résiduel non orienté, capacités initiales
+    Algorithme     algo;
+    int            n;
+    int           *parent;
+    Capacite      *coupe;
+    CoupeCalculee *coupes;
+    int            prochain;        // prochain sommet à distribuer
+    int            valide;          // prochain sommet dont la coupe doit être appliquée
+    int            refaire;         // coupe à recalculer (-1 : aucune)
+    int            avance;
+    DinicStatut    statut;
+    pthread_mutex_t verrou;
+    pthread_cond_t  progres;
+} GomoryHu;
+
+typedef struct {
+    GomoryHu *gh;
+    Contexte *ctx;                  // contexte propre au thread
+    Graphe    copie;                // topologie de gh->rg, capacités propres
+    DinicStatut statut;
+} TravailleurGH;
+
+/***********************************************************************************************************/
+/* Action ghCouper :                                                                                       */
+/*   - flot maximal de i vers cible sur la copie du thread, remise aux capacités initiales                 */
+/*   - côté de i : sommets accessibles depuis i dans le graphe résiduel final (BFS de buildLevelGraph, le  */
+/*     puits étant inaccessible, tout l'ensemble accessible est parcouru)                                  */
+/***********************************************************************************************************/
+static DinicStatut ghCouper(TravailleurGH *t, int i, int cible, Capacite *valeur, uint64_t *cote) {
+    const Graphe *rg = t->gh->rg;
+    size_t n = (size_t)rg->nbSommets;
+    memcpy(t->copie.capa, rg->capa, (size_t)rg->nbArcs * sizeof *rg->capa);
+    t->copie.source = i;
+    t->copie.puits = cible;
+    DinicStatut statut = resoudre(t->ctx, &t->copie, t->gh->algo, valeur);
+    if (statut != DINIC_OK) return statut;
+
+    int *niveau = reserverTampon(t->ctx, T_NIVEAU, n * sizeof *niveau);
+    int *file   = reserverTampon(t->ctx, T_FILE, n * sizeof *file);
+    if (!niveau || !file) return DINIC_ERREUR_MEMOIRE;
+    buildLevelGraph(&t->copie, 1, niveau, file, &t->ctx->stats);
+    for (size_t v = 0; v < n; v++) {
+        if (niveau[v] >= 0) cote[v >> 6] |= (uint64_t)1 << (v & 63);
+    }
+    return DINIC_OK;
+}
+
+/***********************************************************************************************************/
+/* Action ghAppliquer :                                                                                    */
+/*   - applique dans l'ordre des sommets les coupes prêtes (verrou tenu) ; s'arrête sur une coupe          */
+/*     calculée avec un parent devenu faux, qui est remise à calculer                                      */
+/***********************************************************************************************************/
+static void ghAppliquer(GomoryHu *gh) {
+    while (gh->valide < gh->n && gh->coupes[gh->valide].pret) {
+        int i = gh->valide;
+        CoupeCalculee *c = &gh->coupes[i];
+        c->pret = false;
+        if (c->cible == gh->parent[i]) {
+            gh->coupe[i] = c->valeur;
+            for (int j = i + 1; j < gh->n; j++) {
+                if (gh->parent[j] == c->cible && ((c->cote[j >> 6] >> (j & 63)) & 1)) gh->parent[j] = i;
+            }
+            gh->valide++;
+        } else {
+            gh->refaire = i;
+        }
+        free(c->cote);
+        c->cote = NULL;
+        if (gh->refaire >= 0) break;
+    }
+}
+
+static void* ghTravailleur(void *arg) {
+    TravailleurGH *t = arg;
+    GomoryHu *gh = t->gh;
+    size_t nbMots = ((size_t)gh->n + 63) / 64;
+    pthread_mutex_lock(&gh->verrou);
+    while (gh->statut == DINIC_OK && gh->valide < gh->n) {
+        int i;
+        if (gh->refaire >= 0) {
+            i = gh->refaire;
+            gh->refaire = -1;
+        } else if (gh->prochain < gh->n && gh->prochain < gh->valide + gh->avance) {
+            i = gh->prochain++;
+        } else {
+            pthread_cond_wait(&gh->progres, &gh->verrou);
+            continue;
+        }
+        int cible = gh->parent[i];
+        pthread_mutex_unlock(&gh->verrou);
+
+        Capacite valeur = 0;
+        uint64_t *cote = calloc(nbMots, sizeof *cote);
+        DinicStatut statut = cote ? ghCouper(t, i, cible, &valeur, cote) : DINIC_ERREUR_MEMOIRE;
+
+        pthread_mutex_lock(&gh->verrou);
+        if (statut != DINIC_OK) {
+            free(cote);
+            t->statut = statut;
+            if (gh->statut == DINIC_OK) gh->statut = statut;
+        } else {
+            gh->coupes[i] = (CoupeCalculee){ .cible = cible, .valeur = valeur, .cote = cote, .pret = true };
+            ghAppliquer(gh);
+        }
+        pthread_cond_broadcast(&gh->progres);
+    }
+    pthread_mutex_unlock(&gh->verrou);
+    return NULL;
+}
+
+// compteurs des threads ajoutés à ceux du contexte appelant
+static void ghCumuler(Statistiques *st, const Statistiques *s) {
+    st->tempsBfs += s->tempsBfs;
+    st->tempsAugmentation += s->tempsAugmentation;
+    st->nbBfs += s->nbBfs;
+    st->nbChemins += s->nbChemins;
+    st->longueurChemins += s->longueurChemins;
+    st->nbPoussees += s->nbPoussees;
+    st->nbReetiquetages += s->nbReetiquetages;
+    st->arcsParcourus += s->arcsParcourus;
+}
+
+/***********************************************************************************************************/
+/* Action gomoryHu :                                                                                       */
+/*   - graphe résiduel non orienté (les deux arcs d'une paire reçoivent la capacité de l'arc), puis        */
+/*     coupes de Gusfield réparties sur les threads du contexte ; les threads en surnombre par rapport     */
+/*     aux coupes sont laissés à chaque flot (definirThreads des contextes des travailleurs)               */
+/*   - parent[i] < i pour tout i >= 2 : les profondeurs se calculent en une passe                          */
+/***********************************************************************************************************/
+DinicStatut gomoryHu(Contexte *ctx, Graphe *g, Algorithme algo, ArbreCoupes **res) {
+    *res = NULL;
+    ctx->erreur[0] = '\0';
+    if (algo != ALGO_DINIC && algo != ALGO_SCALING && algo != ALGO_HIPR && algo != ALGO_PARALLELE &&
+        algo != ALGO_BK) {
+        return fixerErreur(ctx, DINIC_ERREUR_PARAMETRE, "algorithme inconnu (%d)", (int)algo);
+    }
+    Graphe *rg = NULL;
+    DinicStatut statut = buildResidualGraph(ctx, g, &rg);
+    if (statut != DINIC_OK) return statut;
+    for (int e = 0; e < g->nbArcs; e++) {
+        int d = g->arcResiduel[e];
+        rg->capa[d] = g->capa[e];
+        rg->capa[rg->inverse[d]] = g->capa[e];
+    }
+
+    int n = g->nbSommets;
+    ArbreCoupes *a = calloc(1, sizeof *a);
+    GomoryHu gh = { .rg = rg, .algo = algo, .n = n, .prochain = 2, .valide = 2, .refaire = -1 };
+    if (a) {
+        a->nbSommets = n;
+        a->parent = calloc((size_t)n, sizeof *a->parent);
+        a->coupe = calloc((size_t)n, sizeof *a->coupe);
+        a->profondeur = calloc((size_t)n, sizeof *a->profondeur);
+        gh.coupes = calloc((size_t)n, sizeof *gh.coupes);
+    }
+    if (!a || !a->parent || !a->coupe || !a->profondeur || !gh.coupes) {
+        free(gh.coupes);
+        libererArbreCoupes(a);
+        freeGraph(rg);
+        return fixerErreur(ctx, DINIC_ERREUR_MEMOIRE, "arbre de Gomory-Hu de %d sommets trop grand", n - 1);
+    }
+    for (int v = 2; v < n; v++) a->parent[v] = 1;
+    gh.parent = a->parent;
+    gh.coupe = a->coupe;
+
+    double debut = maintenant();
+    int nbThreads = nombreThreads(ctx);
+    int nbCoupes = (n > 2) ? n - 2 : 1;
+    int lances = nbThreads;
+    if (lances > GH_MAX_THREADS) lances = GH_MAX_THREADS;
+    if (lances > nbCoupes) lances = nbCoupes;
+    TravailleurGH travailleurs[GH_MAX_THREADS];
+    int prets = 0;
+    for (; prets < lances; prets++) {
+        TravailleurGH *t = &travailleurs[prets];
+        *t = (TravailleurGH){ .gh = &gh, .ctx = creerContexte(), .copie = *rg };
+        t->copie.capa = malloc(((size_t)rg->nbArcs + 1) * sizeof *t->copie.capa);
+        if (!t->ctx || !t->copie.capa) {
+            libererContexte(t->ctx);
+            free(t->copie.capa);
+            break;
+        }
+        definirThreads(t->ctx, nbThreads / lances);
+    }
+    if (prets == 0) statut = fixerErreur(ctx, DINIC_ERREUR_MEMOIRE, "contexte de calcul impossible à créer");
+
+    if (statut == DINIC_OK) {
+        gh.avance = GH_AVANCE * prets;
+        pthread_mutex_init(&gh.verrou, NULL);
+        pthread_cond_init(&gh.progres, NULL);
+        pthread_t threads[GH_MAX_THREADS];
+        int demarres = 1;
+        for (; demarres < prets; demarres++) {
+            if (pthread_create(&threads[demarres], NULL, ghTravailleur, &travailleurs[demarres]) != 0) break;
+        }
+        ghTravailleur(&travailleurs[0]);
+        for (int t = 1; t < demarres; t++) pthread_join(threads[t], NULL);
+        pthread_cond_destroy(&gh.progres);
+        pthread_mutex_destroy(&gh.verrou);
+
+        statut = gh.statut;
+        bool signale = false;
+        for (int t = 0; t < prets; t++) {
+            if (!signale && travailleurs[t].statut != DINIC_OK) {
+                fixerErreur(ctx, statut, "%s", derniereErreur(travailleurs[t].ctx));
+                signale = true;
+            }
+            ghCumuler(&ctx->stats, &travailleurs[t].ctx->stats);
+        }
+    }
+    for (int t = 0; t < prets; t++) {
+        libererContexte(travailleurs[t].ctx);
+        free(travailleurs[t].copie.capa);
+    }
+    for (int v = 0; v < n; v++) free(gh.coupes[v].cote);
+    free(gh.coupes);
+    freeGraph(rg);
+    ctx->stats.tempsResolution += maintenant() - debut;
+    if (statut != DINIC_OK) {
+        libererArbreCoupes(a);
+        return statut;
+    }
+    for (int v = 2; v < n; v++) a->profondeur[v] = a->profondeur[a->parent[v]] + 1;
+    *res = a;
+    return DINIC_OK;
+}
+
+/***********************************************************************************************************/
+/* Action coupeMinimale :                                                                                  */
+/*   - remonte u et v vers leur ancêtre commun (le plus profond d'abord) : O(longueur du chemin)           */
+/***********************************************************************************************************/
+Capacite coupeMinimale(const ArbreCoupes *a, int u, int v) {
+    if (u < 1 || v < 1 || u >= a->nbSommets || v >= a->nbSommets) return -1;
+    Capacite k = CAPACITE_MAX;
+    while (u != v) {
+        if (a->profondeur[u] < a->profondeur[v]) {
+            int w = u;
+            u = v;
+            v = w;
+        }
+        if (a->coupe[u] < k) k = a->coupe[u];
+        u = a->parent[u];
+    }
+    return k;
+}
+
+/***********************************************************************************************************/
+/* Action ecrireArbreCoupes :                                                                              */
+/*   - une ligne par sommet autre que la racine : "<v> -> <parent> : coupe <c>"                            */
+/***********************************************************************************************************/
+DinicStatut ecrireArbreCoupes(Contexte *ctx, const ArbreCoupes *a, const char *chemin) {
+    double debut = maintenant();
+    FILE *fout = fopen(chemin, "w");
+    if (!fout) {
+        return fixerErreur(ctx, DINIC_ERREUR_FICHIER, "impossible de créer le fichier %s : %s", chemin, strerror(errno));
+    }
+    fprintf(fout, "Arbre de Gomory-Hu : %d sommets, racine 1\n", a->nbSommets - 1);
+    fprintf(fout, "(coupe minimale entre u et v : plus petite coupe du chemin de u à v)\n\n");
+    for (int v = 2; v < a->nbSommets; v++) {
+        fprintf(fout, "%d -> %d : coupe %" PRId64 "\n", v, a->parent[v], a->coupe[v]);
+    }
+    if (fclose(fout) != 0) {
+        return fixerErreur(ctx, DINIC_ERREUR_FICHIER, "écriture de %s : %s", chemin, strerror(errno));
+    }
+    ctx->stats.tempsEcriture += maintenant() - debut;
+    return DINIC_OK;
+}
+
+void libererArbreCoupes(ArbreCoupes *a) {
+    if (!a) return;
+    free(a->parent);
+    free(a->coupe);
+    free(a->profondeur);
+    free(a);
+}
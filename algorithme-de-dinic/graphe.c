@@ -0,0 +1,953 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <limits.h>
+#include <inttypes.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "dinic_interne.h"
+
+// -----------------------------------------------------------------------------
+// Construction des graphes : réseau initial (DIMACS), graphe résiduel,
+// report des flots et écriture du résultat
+// -----------------------------------------------------------------------------
+
+/***********************************************************************************************************/
+/* Action allocGraph :                                                                                     */
+/*   - alloue un Graphe CSR vide de nbSommets sommets et nbArcs arcs (tableaux non initialisés)            */
+/*   - residuel : true pour réserver 'inverse', false pour réserver 'flot' et 'arcResiduel'                */
+/*   - retourne : Graphe* ou NULL si la mémoire manque (rien n'est alors alloué)                           */
+/***********************************************************************************************************/
+Graphe* allocGraph(int nbSommets, int nbArcs, bool residuel) {
+    Graphe *g = malloc(sizeof *g);
+    if (!g) return NULL;
+    size_t m = (nbArcs > 0) ? (size_t)nbArcs : 1;
+    *g = (Graphe){ .nbSommets = nbSommets, .nbArcs = nbArcs, .source = -1, .puits = -1 };
+    g->debut      = malloc(((size_t)nbSommets + 1) * sizeof *g->debut);
+    g->SommetDest = malloc(m * sizeof *g->SommetDest);
+    g->capa       = malloc(m * sizeof *g->capa);
+    if (residuel) g->inverse = malloc(m * sizeof *g->inverse);
+    else {
+        g->flot        = malloc(m * sizeof *g->flot);
+        g->arcResiduel = malloc(m * sizeof *g->arcResiduel);
+    }
+    if (!g->debut || !g->SommetDest || !g->capa || (residuel ? !g->inverse : !g->flot || !g->arcResiduel)) {
+        freeGraph(g);
+        return NULL;
+    }
+    return g;
+}
+
+/***********************************************************************************************************/
+/* Action prefixSum :                                                                                      */
+/*   - transforme debut[] (degré de chaque sommet) en indices de début CSR, debut[n] = nombre d'arcs       */
+/***********************************************************************************************************/
+void prefixSum(int *debut, int n) {
+    int cumul = 0;
+    for (int u = 0; u < n; u++) {
+        int d = debut[u];
+        debut[u] = cumul;
+        cumul += d;
+    }
+    debut[n] = cumul;
+}
+
+// -----------------------------------------------------------------------------
+// Chargement DIMACS : fichier projeté en mémoire (mmap), découpé en blocs de
+// lignes entières analysés en parallèle par des threads.
+//
+// - LecteurDimacs      : curseur sur une ligne du fichier projeté.
+//   - lireNombre       : lit un entier décimal borné (sans sscanf) ou échoue.
+//   - lireEntier       : numéro de sommet ou compteur (int).
+//   - lireCapacite     : capacité sur 64 bits.
+//   - finDeLigne       : vérifie qu'il ne reste que des blancs sur la ligne.
+// - BlocDimacs         : bloc de lignes confié à un thread.
+//   - compterBloc      : passe 1, compte les lignes et les lignes 'a' du bloc.
+//   - analyserBloc     : passe 2, écrit les arcs du bloc à leur rang définitif.
+// -----------------------------------------------------------------------------
+#define DIMACS_BLOC_MIN   (1 << 20)   // taille minimale d'un bloc (octets)
+#define DIMACS_MAX_THREADS 64
+#define DIMACS_MAX_ERREURS 8          // erreurs mémorisées par bloc
+
+typedef struct {
+    const char *p;
+    const char *fin;
+} LecteurDimacs;
+
+static bool estBlanc(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+static void sauterBlancs(LecteurDimacs *l) {
+    while (l->p < l->fin && estBlanc(*l->p)) l->p++;
+}
+
+static bool lireNombre(LecteurDimacs *l, int64_t max, int64_t *res) {
+    sauterBlancs(l);
+    bool negatif = false;
+    if (l->p < l->fin && (*l->p == '-' || *l->p == '+')) negatif = (*l->p++ == '-');
+    if (l->p >= l->fin || *l->p < '0' || *l->p > '9') return false;
+    int64_t v = 0;
+    while (l->p < l->fin && *l->p >= '0' && *l->p <= '9') {
+        int chiffre = *l->p++ - '0';
+        if (v > (max - chiffre) / 10) return false;
+        v = v * 10 + chiffre;
+    }
+    if (l->p < l->fin && !estBlanc(*l->p) && *l->p != '\n') return false;
+    *res = negatif ? -v : v;
+    return true;
+}
+
+static bool lireEntier(LecteurDimacs *l, int *res) {
+    int64_t v;
+    if (!lireNombre(l, INT_MAX, &v)) return false;
+    *res = (int)v;
+    return true;
+}
+
+static bool lireCapacite(LecteurDimacs *l, Capacite *res) {
+    return lireNombre(l, CAPACITE_MAX, res);
+}
+
+static bool finDeLigne(LecteurDimacs *l) {
+    sauterBlancs(l);
+    return l->p >= l->fin || *l->p == '\n';
+}
+
+static const char *ligneSuivante(const char *p, const char *fin) {
+    const char *nl = memchr(p, '\n', fin - p);
+    return nl ? nl + 1 : fin;
+}
+
+typedef struct {
+    const char *debut, *fin;     // lignes [debut, fin) du bloc
+    int   n;                     // nombre de sommets annoncé
+    long  premiereLigne;         // numéro (1..) de la première ligne du bloc
+    long  nbLignes;              // passe 1 : nombre de lignes du bloc
+    int   nbArcs;                // passe 1 : nombre de lignes 'a'
+    int   premierArc;            // rang global du premier arc du bloc
+    int  *origine, *dest;        // tableaux globaux des arcs (ordre du fichier)
+    Capacite *capa;
+    int   source, puits;         // dernières lignes 'n' du bloc, -1 sinon
+    int   nbErreurs;
+    long  ligneErreur[DIMACS_MAX_ERREURS];
+    const char *msgErreur[DIMACS_MAX_ERREURS];
+} BlocDimacs;
+
+static void signalerErreur(BlocDimacs *b, long ligne, const char *msg) {
+    if (b->nbErreurs < DIMACS_MAX_ERREURS) {
+        b->ligneErreur[b->nbErreurs] = ligne;
+        b->msgErreur[b->nbErreurs] = msg;
+    }
+    b->nbErreurs++;
+}
+
+static void *compterBloc(void *arg) {
+    BlocDimacs *b = arg;
+    long lignes = 0;
+    int arcs = 0;
+    for (const char *p = b->debut; p < b->fin; p = ligneSuivante(p, b->fin)) {
+        lignes++;
+        if (*p == 'a') arcs++;
+    }
+    b->nbLignes = lignes;
+    b->nbArcs = arcs;
+    return NULL;
+}
+
+static void *analyserBloc(void *arg) {
+    BlocDimacs *b = arg;
+    long ligne = b->premiereLigne;
+    int i = b->premierArc;
+    for (const char *p = b->debut; p < b->fin; p = ligneSuivante(p, b->fin), ligne++) {
+        LecteurDimacs l = { p + 1, b->fin };
+        switch (*p) {
+        case 'a': {
+            int u, v;
+            Capacite c;
+            if (!lireEntier(&l, &u) || !lireEntier(&l, &v) || !lireCapacite(&l, &c) || !finDeLigne(&l)) {
+                signalerErreur(b, ligne, "ligne 'a' mal formée (attendu : a <u> <v> <capacité>)");
+                b->origine[i] = 1; b->dest[i] = 1; b->capa[i] = 0;
+            } else if (u < 1 || u > b->n || v < 1 || v > b->n) {
+                signalerErreur(b, ligne, "sommet hors de [1, n]");
+                b->origine[i] = 1; b->dest[i] = 1; b->capa[i] = 0;
+            } else if (c < 0) {
+                signalerErreur(b, ligne, "capacité négative");
+                b->origine[i] = 1; b->dest[i] = 1; b->capa[i] = 0;
+            } else {
+                b->origine[i] = u; b->dest[i] = v; b->capa[i] = c;
+            }
+            i++;
+            break;
+        }
+        case 'n': {
+            int id;
+            sauterBlancs(&l);
+            if (!lireEntier(&l, &id) || id < 1 || id > b->n) {
+                signalerErreur(b, ligne, "ligne 'n' mal formée ou sommet hors de [1, n]");
+                break;
+            }
+            sauterBlancs(&l);
+            char t = (l.p < l.fin) ? *l.p++ : '\0';
+            if ((t != 's' && t != 't') || !finDeLigne(&l)) {
+                signalerErreur(b, ligne, "ligne 'n' : type attendu 's' ou 't'");
+            } else if (t == 's') {
+                b->source = id;
+            } else {
+                b->puits = id;
+            }
+            break;
+        }
+        case 'c':
+        case '\n':
+        case '\r':
+            break;
+        case 'p':
+            signalerErreur(b, ligne, "ligne 'p' en double");
+            break;
+        default:
+            if (!finDeLigne(&(LecteurDimacs){ p, b->fin })) signalerErreur(b, ligne, "ligne non reconnue");
+            break;
+        }
+    }
+    return NULL;
+}
+
+/***********************************************************************************************************/
+/* Action lancerBlocs :                                                                                    */
+/*   - exécute fn sur chaque bloc, un thread par bloc (le bloc 0 est traité par le thread appelant)        */
+/***********************************************************************************************************/
+static void lancerBlocs(BlocDimacs *blocs, int nbBlocs, void *(*fn)(void *)) {
+    pthread_t threads[DIMACS_MAX_THREADS];
+    bool lance[DIMACS_MAX_THREADS] = { false };
+    for (int t = 1; t < nbBlocs; t++) {
+        lance[t] = (pthread_create(&threads[t], NULL, fn, &blocs[t]) == 0);
+        if (!lance[t]) fn(&blocs[t]);
+    }
+    fn(&blocs[0]);
+    for (int t = 1; t < nbBlocs; t++) {
+        if (lance[t]) pthread_join(threads[t], NULL);
+    }
+}
+
+/***********************************************************************************************************/
+/* Action buildGraph :                                                                                     */
+/*   - lit un fichier DIMACS et construit le réseau initial                                               */
+/*   - paramètres : Contexte* ctx, const char* filename (chemin du fichier DIMACS), Graphe** res           */
+/*   - retourne : DINIC_OK et *res initialisé (flots à 0), ou un code d'erreur et *res = NULL              */
+/* Fonctionnement :                                                                                        */
+/*   1. Projection du fichier en mémoire (mmap) : aucune copie ni tampon de ligne                          */
+/*   2. Lecture de l'en-tête jusqu'à la ligne 'p' (nombre de sommets n et d'arcs m)                        */
+/*   3. Découpage du reste en blocs de lignes entières, un par thread                                      */
+/*   4. Passe 1 (parallèle) : comptage des lignes et des arcs de chaque bloc -> rang du premier arc        */
+/*   5. Passe 2 (parallèle) : analyse des lignes 'n' et 'a' ; chaque arc est écrit directement à son rang  */
+/*      dans des tableaux de m cases (zones de travail du contexte), ce qui conserve l'ordre du fichier    */
+/*   6. Les lignes mal formées sont signalées avec leur numéro dans derniereErreur et le chargement échoue */
+/*   7. Tri par dénombrement des arcs sur leur origine -> tableaux CSR                                     */
+/***********************************************************************************************************/
+DinicStatut buildGraph(Contexte *ctx, const char *filename, Graphe **res) {
+    *res = NULL;
+    ctx->erreur[0] = '\0';
+    double debut = maintenant();
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return fixerErreur(ctx, DINIC_ERREUR_FICHIER, "%s : %s", filename, strerror(errno));
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return fixerErreur(ctx, DINIC_ERREUR_FICHIER, "%s : %s", filename, strerror(errno));
+    }
+    size_t taille = (size_t)st.st_size;
+    const char *texte = NULL;
+    if (taille > 0) {
+        texte = mmap(NULL, taille, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (texte == MAP_FAILED) {
+            close(fd);
+            return fixerErreur(ctx, DINIC_ERREUR_FICHIER, "%s : mmap : %s", filename, strerror(errno));
+        }
+        (void)madvise((void *)texte, taille, MADV_SEQUENTIAL);
+    }
+    close(fd);
+    const char *fin = texte + taille;
+    DinicStatut statut = DINIC_OK;
+
+    // en-tête : commentaires puis ligne 'p'
+    int n = 0, m = -1;
+    long ligne = 1;
+    const char *p = texte;
+    for (; p < fin && m < 0; p = ligneSuivante(p, fin), ligne++) {
+        if (*p == 'c' || *p == '\n' || *p == '\r') continue;
+        LecteurDimacs l = { p + 1, fin };
+        sauterBlancs(&l);
+        const char *mot = l.p;
+        while (l.p < l.fin && !estBlanc(*l.p) && *l.p != '\n') l.p++;
+        if (*p != 'p' || l.p == mot || !lireEntier(&l, &n) || !lireEntier(&l, &m) || !finDeLigne(&l) || m < 0) {
+            statut = fixerErreur(ctx, DINIC_ERREUR_FORMAT, "%s:%ld : ligne 'p' attendue (p max <n> <m>)", filename, ligne);
+            goto fin;
+        }
+    }
+    if (n <= 0) { statut = fixerErreur(ctx, DINIC_ERREUR_FORMAT, "%s : DIMACS invalide: nb sommets", filename); goto fin; }
+
+    // découpage en blocs de lignes entières
+    BlocDimacs blocs[DIMACS_MAX_THREADS];
+    size_t reste = (size_t)(fin - p);
+    int nbBlocs = (int)(reste / DIMACS_BLOC_MIN) + 1;
+    if (nbBlocs > nombreThreads(ctx)) nbBlocs = nombreThreads(ctx);
+    if (nbBlocs > DIMACS_MAX_THREADS) nbBlocs = DIMACS_MAX_THREADS;
+    const char *coupe = p;
+    for (int t = 0; t < nbBlocs; t++) {
+        const char *limite = (t == nbBlocs - 1) ? fin : p + reste / nbBlocs * (t + 1);
+        if (limite < coupe) limite = coupe;
+        if (limite > p && limite < fin && limite[-1] != '\n') limite = ligneSuivante(limite, fin);
+        blocs[t] = (BlocDimacs){ .debut = coupe, .fin = limite, .n = n, .source = -1, .puits = -1 };
+        coupe = limite;
+    }
+
+    lancerBlocs(blocs, nbBlocs, compterBloc);
+    int nbArcs = 0;
+    for (int t = 0; t < nbBlocs; t++) {
+        blocs[t].premiereLigne = ligne;
+        blocs[t].premierArc = nbArcs;
+        ligne += blocs[t].nbLignes;
+        nbArcs += blocs[t].nbArcs;
+    }
+    if (nbArcs != m) {
+        statut = fixerErreur(ctx, DINIC_ERREUR_FORMAT, "%s : la ligne 'p' annonce %d arcs mais le fichier en contient %d",
+                             filename, m, nbArcs);
+        goto fin;
+    }
+
+    int *origine   = reserverTampon(ctx, T_ORIGINE, (size_t)m * sizeof *origine);
+    int *dest      = reserverTampon(ctx, T_DEST, (size_t)m * sizeof *dest);
+    Capacite *capa = reserverTampon(ctx, T_CAPA, (size_t)m * sizeof *capa);
+    int *pos       = reserverTampon(ctx, T_POSITION, ((size_t)n + 1) * sizeof *pos);
+    if (!origine || !dest || !capa || !pos) { statut = DINIC_ERREUR_MEMOIRE; goto fin; }
+    for (int t = 0; t < nbBlocs; t++) {
+        blocs[t].origine = origine; blocs[t].dest = dest; blocs[t].capa = capa;
+    }
+    lancerBlocs(blocs, nbBlocs, analyserBloc);
+
+    int src = -1, snk = -1, nbErreurs = 0;
+    for (int t = 0; t < nbBlocs; t++) {
+        if (blocs[t].source >= 0) src = blocs[t].source;
+        if (blocs[t].puits >= 0) snk = blocs[t].puits;
+        for (int k = 0; k < blocs[t].nbErreurs && k < DIMACS_MAX_ERREURS; k++) {
+            ajouterErreur(ctx, "%s:%ld : %s", filename, blocs[t].ligneErreur[k], blocs[t].msgErreur[k]);
+        }
+        if (blocs[t].nbErreurs > DIMACS_MAX_ERREURS) {
+            ajouterErreur(ctx, "%s : ... %d autres erreurs", filename, blocs[t].nbErreurs - DIMACS_MAX_ERREURS);
+        }
+        nbErreurs += blocs[t].nbErreurs;
+    }
+    if (nbErreurs > 0) {
+        ajouterErreur(ctx, "DIMACS invalide: %d ligne(s) mal formée(s)", nbErreurs);
+        statut = DINIC_ERREUR_FORMAT;
+        goto fin;
+    }
+    if (src < 1 || src > n || snk < 1 || snk > n) {
+        statut = fixerErreur(ctx, DINIC_ERREUR_FORMAT, "%s : source ou puits manquant", filename);
+        goto fin;
+    }
+
+    Graphe *g = allocGraph(n + 1, m, false);
+    if (!g) { statut = fixerErreur(ctx, DINIC_ERREUR_MEMOIRE, "graphe de %d arcs trop grand", m); goto fin; }
+    g->source = src; g->puits = snk;
+    for (int u = 0; u <= n + 1; u++) g->debut[u] = 0;
+    for (int i = 0; i < m; i++) g->debut[origine[i]]++;
+    prefixSum(g->debut, n + 1);
+
+    // tri stable : les arcs d'un même sommet gardent l'ordre du fichier
+    memcpy(pos, g->debut, ((size_t)n + 1) * sizeof *pos);
+    for (int i = 0; i < m; i++) {
+        int e = pos[origine[i]]++;
+        g->SommetDest[e] = dest[i];
+        g->capa[e] = capa[i];
+        g->flot[e] = 0;
+    }
+    *res = g;
+
+fin:
+    if (texte) munmap((void *)texte, taille);
+    ctx->stats.tempsChargement += maintenant() - debut;
+    return statut;
+}
+
+/***********************************************************************************************************/
+/* Action buildResidualGraph :                                                                            */
+/*   - construit le graphe résiduel à partir du réseau initial                                             */
+/*   - crée pour chaque arc (u->v) deux arcs : direct (c-f) rangé chez u et inverse (f) rangé chez v       */
+/*   - les deux arcs sont appariés : inverse[direct] = inverse et inverse[inverse] = direct, ce qui rend   */
+/*     chaque mise à jour résiduelle en O(1)                                                               */
+/*   - g->arcResiduel[e] reçoit l'indice de l'arc direct de e : les flots se relisent sans recherche       */
+/*   - tri par dénombrement : degré résiduel = degré sortant + degré entrant                               */
+/*   - paramètres : Contexte* ctx, Graphe* g (réseau initial), Graphe** res                                */
+/*   - retourne : DINIC_OK et *res = graphe résiduel, ou DINIC_ERREUR_MEMOIRE et *res = NULL               */
+/***********************************************************************************************************/
+DinicStatut buildResidualGraph(Contexte *ctx, Graphe *g, Graphe **res) {
+    *res = NULL;
+    double debut = maintenant();
+    int n = g->nbSommets;
+    int *pos = reserverTampon(ctx, T_POSITION, (size_t)n * sizeof *pos);
+    if (!pos) return DINIC_ERREUR_MEMOIRE;
+    Graphe *rg = allocGraph(n, 2 * g->nbArcs, true);
+    if (!rg) return fixerErreur(ctx, DINIC_ERREUR_MEMOIRE, "graphe résiduel de %d arcs trop grand", 2 * g->nbArcs);
+    rg->source = g->source;
+    rg->puits = g->puits;
+
+    for (int u = 0; u <= n; u++) rg->debut[u] = 0;
+    for (int u = 1; u < n; u++) {
+        for (int e = g->debut[u]; e < g->debut[u + 1]; e++) {
+            rg->debut[u]++;
+            rg->debut[g->SommetDest[e]]++;
+        }
+    }
+    prefixSum(rg->debut, n);
+
+    memcpy(pos, rg->debut, (size_t)n * sizeof *pos);
+    for (int u = 1; u < n; u++) {
+        for (int e = g->debut[u]; e < g->debut[u + 1]; e++) {
+            int v = g->SommetDest[e];
+            int d = pos[u]++;
+            int r = pos[v]++;
+            rg->SommetDest[d] = v;
+            rg->capa[d] = g->capa[e] - g->flot[e];
+            rg->inverse[d] = r;
+            g->arcResiduel[e] = d;
+            rg->SommetDest[r] = u;
+            rg->capa[r] = g->flot[e];
+            rg->inverse[r] = d;
+        }
+    }
+    *res = rg;
+    ctx->stats.tempsResiduel += maintenant() - debut;
+    return DINIC_OK;
+}
+
+/***********************************************************************************************************/
+/* Action updateNetworkFlow :                                                                               */
+/*   - applique dans le réseau initial les flots calculés dans le graphe résiduel                            */
+/*   - chaque arc lit directement son arc résiduel (g->arcResiduel) : une seule passe en O(E), correcte    */
+/*     même avec plusieurs arcs parallèles u -> v                                                          */
+/*   - paramètres : const Graphe* rg (graphe résiduel), Graphe* g (réseau initial)                         */
+/***********************************************************************************************************/
+void updateNetworkFlow(const Graphe *rg, Graphe *g) {
+    for (int e = 0; e < g->nbArcs; e++) {
+        g->flot[e] = g->capa[e] - rg->capa[g->arcResiduel[e]];
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Écriture du résultat : les lignes sont formatées à la main dans un bloc de
+// ECRITURE_BLOC octets, vidé par un seul fwrite quand il est plein
+// -----------------------------------------------------------------------------
+#define ECRITURE_BLOC  (1 << 20)
+#define ECRITURE_LIGNE 128            // longueur maximale d'une ligne formatée
+
+typedef struct {
+    FILE  *f;
+    char  *bloc;
+    size_t lg;
+    bool   echec;
+} Ecrivain;
+
+static void viderEcrivain(Ecrivain *w) {
+    if (w->lg && fwrite(w->bloc, 1, w->lg, w->f) != w->lg) w->echec = true;
+    w->lg = 0;
+}
+
+// garantit la place d'une ligne dans le bloc
+static inline void reserverLigne(Ecrivain *w) {
+    if (w->lg > ECRITURE_BLOC - ECRITURE_LIGNE) viderEcrivain(w);
+}
+
+static inline void ecrireOctets(Ecrivain *w, const char *s, size_t n) {
+    memcpy(w->bloc + w->lg, s, n);
+    w->lg += n;
+}
+
+#define ECRIRE_LITTERAL(w, s) ecrireOctets((w), (s), sizeof(s) - 1)
+
+// entier décimal, deux chiffres par division
+static inline void ecrireEntier(Ecrivain *w, int64_t x) {
+    static const char paires[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    char tmp[20];
+    char *p = tmp + sizeof tmp;
+    uint64_t u = (uint64_t)x;
+    if (x < 0) {
+        w->bloc[w->lg++] = '-';
+        u = 0 - u;
+    }
+    while (u >= 100) {
+        unsigned r = (unsigned)(u % 100);
+        u /= 100;
+        p -= 2;
+        memcpy(p, paires + 2 * r, 2);
+    }
+    if (u >= 10) {
+        p -= 2;
+        memcpy(p, paires + 2 * u, 2);
+    } else {
+        *--p = (char)('0' + u);
+    }
+    ecrireOctets(w, p, (size_t)(tmp + sizeof tmp - p));
+}
+
+// "u -> v : flux f / capacité c" pour chaque arc
+static void ecrireFlux(Ecrivain *w, const Graphe *res) {
+    for (int u = 1; u < res->nbSommets; u++) {
+        for (int e = res->debut[u]; e < res->debut[u + 1]; e++) {
+            reserverLigne(w);
+            ecrireEntier(w, u);
+            ECRIRE_LITTERAL(w, " -> ");
+            ecrireEntier(w, res->SommetDest[e]);
+            ECRIRE_LITTERAL(w, " : flux ");
+            ecrireEntier(w, res->flot[e]);
+            ECRIRE_LITTERAL(w, " / capacité ");
+            ecrireEntier(w, res->capa[e]);
+            ECRIRE_LITTERAL(w, "\n");
+        }
+    }
+}
+
+/***********************************************************************************************************/
+/* Action ecrireCoupe :                                                                                    */
+/*   - côté source de la coupe minimale : sommets accessibles depuis la source dans le résiduel du flot    */
+/*     final (arc u -> v non saturé, ou arc v -> u de flux positif), puis arcs saturés qui le quittent     */
+/*   - les arcs de flux positif sont rangés par destination (T_POSITION, T_ENTRANTS) pour le parcours      */
+/*     arrière ; le réseau initial n'a pas d'arcs inverses                                                 */
+/***********************************************************************************************************/
+static DinicStatut ecrireCoupe(Contexte *ctx, Ecrivain *w, const Graphe *res) {
+    int n = res->nbSommets, m = res->nbArcs;
+    int *pos      = reserverTampon(ctx, T_POSITION, ((size_t)n + 1) * sizeof *pos);
+    int *entrants = reserverTampon(ctx, T_ENTRANTS, (size_t)(m > 0 ? m : 1) * sizeof *entrants);
+    int *cote     = reserverTampon(ctx, T_NIVEAU, (size_t)n * sizeof *cote);
+    int *file     = reserverTampon(ctx, T_FILE, (size_t)n * sizeof *file);
+    if (!pos || !entrants || !cote || !file) return DINIC_ERREUR_MEMOIRE;
+
+    memset(pos, 0, ((size_t)n + 1) * sizeof *pos);
+    for (int e = 0; e < m; e++) {
+        if (res->flot[e] > 0) pos[res->SommetDest[e]]++;
+    }
+    for (int v = 1; v <= n; v++) pos[v] += pos[v - 1];
+    for (int u = 1; u < n; u++) {
+        for (int e = res->debut[u]; e < res->debut[u + 1]; e++) {
+            if (res->flot[e] > 0) entrants[--pos[res->SommetDest[e]]] = u;
+        }
+    }
+
+    memset(cote, 0, (size_t)n * sizeof *cote);
+    int tete = 0, queue = 0, nbCote = 0;
+    cote[res->source] = 1;
+    file[queue++] = res->source;
+    while (tete < queue) {
+        int u = file[tete++];
+        nbCote++;
+        for (int e = res->debut[u]; e < res->debut[u + 1]; e++) {
+            int v = res->SommetDest[e];
+            if (!cote[v] && res->flot[e] < res->capa[e]) {
+                cote[v] = 1;
+                file[queue++] = v;
+            }
+        }
+        for (int i = pos[u]; i < pos[u + 1]; i++) {
+            int v = entrants[i];
+            if (!cote[v]) {
+                cote[v] = 1;
+                file[queue++] = v;
+            }
+        }
+    }
+
+    int nbArcs = 0;
+    for (int u = 1; u < n; u++) {
+        if (!cote[u]) continue;
+        for (int e = res->debut[u]; e < res->debut[u + 1]; e++) nbArcs += !cote[res->SommetDest[e]];
+    }
+    reserverLigne(w);
+    ECRIRE_LITTERAL(w, "\nCoupe minimale : ");
+    ecrireEntier(w, nbCote);
+    ECRIRE_LITTERAL(w, " sommet(s) côté source, ");
+    ecrireEntier(w, nbArcs);
+    ECRIRE_LITTERAL(w, " arc(s) saturé(s)\n\nCôté source :\n");
+    int colonne = 0;
+    for (int u = 1; u < n; u++) {
+        if (!cote[u]) continue;
+        reserverLigne(w);
+        ecrireEntier(w, u);
+        if (++colonne == 16) {
+            ECRIRE_LITTERAL(w, "\n");
+            colonne = 0;
+        } else {
+            ECRIRE_LITTERAL(w, " ");
+        }
+    }
+    if (colonne) w->bloc[w->lg - 1] = '\n';
+    reserverLigne(w);
+    ECRIRE_LITTERAL(w, "\nArcs de la coupe :\n");
+    for (int u = 1; u < n; u++) {
+        if (!cote[u]) continue;
+        for (int e = res->debut[u]; e < res->debut[u + 1]; e++) {
+            if (cote[res->SommetDest[e]]) continue;
+            reserverLigne(w);
+            ecrireEntier(w, u);
+            ECRIRE_LITTERAL(w, " -> ");
+            ecrireEntier(w, res->SommetDest[e]);
+            ECRIRE_LITTERAL(w, " : capacité ");
+            ecrireEntier(w, res->capa[e]);
+            ECRIRE_LITTERAL(w, "\n");
+        }
+    }
+    return DINIC_OK;
+}
+
+/***********************************************************************************************************/
+/* Action ecrireResultat :                                                                                  */
+/*   - écrit le flot maximal dans 'chemin', suivi des flux des arcs (SORTIE_TEXTE) ou de la coupe          */
+/*     minimale (SORTIE_COUPE) ; SORTIE_BINAIRE délègue à ecrireFlotsBinaire (binaire.c)                   */
+/*   - paramètres : Contexte* ctx, const Graphe* res (réseau final), Capacite flot_total (flot maximal),   */
+/*                  const char* chemin, ModeSortie mode                                                    */
+/*   - retourne : DINIC_OK, ou DINIC_ERREUR_FICHIER si le fichier ne peut être écrit                       */
+/***********************************************************************************************************/
+DinicStatut ecrireResultat(Contexte *ctx, const Graphe* res, Capacite flot_total, const char *chemin,
+                           ModeSortie mode) {
+    ctx->erreur[0] = '\0';
+    double debut = maintenant();
+    if (mode == SORTIE_BINAIRE) {
+        DinicStatut statut = ecrireFlotsBinaire(ctx, res, flot_total, chemin);
+        ctx->stats.tempsEcriture += maintenant() - debut;
+        return statut;
+    }
+    if (mode != SORTIE_TEXTE && mode != SORTIE_COUPE) {
+        return fixerErreur(ctx, DINIC_ERREUR_PARAMETRE, "mode de sortie inconnu (%d)", (int)mode);
+    }
+    Ecrivain w = { .bloc = reserverTampon(ctx, T_ECRITURE, ECRITURE_BLOC) };
+    if (!w.bloc) return DINIC_ERREUR_MEMOIRE;
+    w.f = fopen(chemin, "w");
+    if (!w.f) {
+        return fixerErreur(ctx, DINIC_ERREUR_FICHIER, "impossible de créer le fichier %s : %s", chemin, strerror(errno));
+    }
+    ECRIRE_LITTERAL(&w, "Flot maximal : ");
+    ecrireEntier(&w, flot_total);
+    DinicStatut statut = DINIC_OK;
+    if (mode == SORTIE_TEXTE) {
+        ECRIRE_LITTERAL(&w, "\n\nFlux sur les arcs :\n");
+        ecrireFlux(&w, res);
+    } else {
+        ECRIRE_LITTERAL(&w, "\n");
+        statut = ecrireCoupe(ctx, &w, res);
+    }
+    viderEcrivain(&w);
+    int erreur = errno;
+    if (fclose(w.f) != 0 && !w.echec) { w.echec = true; erreur = errno; }
+    if (statut == DINIC_OK && w.echec) {
+        statut = fixerErreur(ctx, DINIC_ERREUR_FICHIER, "écriture de %s : %s", chemin, strerror(erreur));
+    }
+    ctx->stats.tempsEcriture += maintenant() - debut;
+    return statut;
+}
+
+/***********************************************************************************************************/
+/* Action freeGraph :                                                                                       */
+/*   - libère la mémoire allouée pour un Graphe                                                            */
+/***********************************************************************************************************/
+void freeGraph(Graphe *g) {
+    if (!g) return;
+    if (g->projection) {
+        munmap(g->projection, g->tailleProjection);
+    } else {
+        free(g->debut);
+        free(g->SommetDest);
+        free(g->capa);
+    }
+    free(g->flot);
+    free(g->inverse);
+    free(g->arcResiduel);
+    free(g);
+}
+
+
+// -----------------------------------------------------------------------------
+// Grilles implicites : directions des voisins, allocation, lecture du format
+// texte et écriture de la coupe en image PBM
+// -----------------------------------------------------------------------------
+
+/***********************************************************************************************************/
+/* Action directionsGrille :                                                                               */
+/*   - 4 et 8 : voisins du plan z = 0 (côtés, puis côtés et diagonales) ; 6 : faces ; 26 : tout le cube    */
+/***********************************************************************************************************/
+int directionsGrille(int connexite, int directions[GRILLE_MAX_VOISINS][3]) {
+    if (connexite != 4 && connexite != 8 && connexite != 6 && connexite != 26) return 0;
+    int K = 0;
+    for (int dz = -1; dz <= 1; dz++) {
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                int norme = abs(dx) + abs(dy) + abs(dz);
+                bool garde = (connexite == 4) ? dz == 0 && norme == 1
+                           : (connexite == 8) ? dz == 0
+                           : (connexite == 6) ? norme == 1 : true;
+                if (norme == 0 || !garde) continue;
+                directions[K][0] = dx;
+                directions[K][1] = dy;
+                directions[K][2] = dz;
+                K++;
+            }
+        }
+    }
+    return K;
+}
+
+int directionGrille(const Grille *g, int dx, int dy, int dz) {
+    int directions[GRILLE_MAX_VOISINS][3];
+    int K = directionsGrille(g->connexite, directions);
+    for (int k = 0; k < K; k++) {
+        if (directions[k][0] == dx && directions[k][1] == dy && directions[k][2] == dz) return k;
+    }
+    return -1;
+}
+
+/***********************************************************************************************************/
+/* Action controlerGrille :                                                                                */
+/*   - connexité 4, 8, 6 ou 26, dimensions >= 1, profondeur 1 en connexité 4 ou 8, arcs indexables sur un  */
+/*     int ; retourne DINIC_OK ou DINIC_ERREUR_PARAMETRE (message fixé)                                    */
+/***********************************************************************************************************/
+DinicStatut controlerGrille(Contexte *ctx, int largeur, int hauteur, int profondeur, int connexite) {
+    int directions[GRILLE_MAX_VOISINS][3];
+    int K = directionsGrille(connexite, directions);
+    if (K == 0 || largeur < 1 || hauteur < 1 || profondeur < 1 ||
+        ((connexite == 4 || connexite == 8) && profondeur != 1)) {
+        return fixerErreur(ctx, DINIC_ERREUR_PARAMETRE, "grille %dx%dx%d de connexité %d invalide",
+                           largeur, hauteur, profondeur, connexite);
+    }
+    int64_t nbVoxels = (int64_t)largeur * hauteur * profondeur;
+    if (nbVoxels * K > INT_MAX) {
+        return fixerErreur(ctx, DINIC_ERREUR_PARAMETRE, "grille de %" PRId64 " voxels trop grande", nbVoxels);
+    }
+    return DINIC_OK;
+}
+
+/***********************************************************************************************************/
+/* Action creerGrille :                                                                                    */
+/*   - contrôle les dimensions puis alloue les trois tableaux à zéro                                       */
+/***********************************************************************************************************/
+DinicStatut creerGrille(Contexte *ctx, int largeur, int hauteur, int profondeur, int connexite, Grille **res) {
+    *res = NULL;
+    DinicStatut statut = controlerGrille(ctx, largeur, hauteur, profondeur, connexite);
+    if (statut != DINIC_OK) return statut;
+    size_t nbVoxels = (size_t)largeur * (size_t)hauteur * (size_t)profondeur;
+    Grille *g = malloc(sizeof *g);
+    if (!g) return fixerErreur(ctx, DINIC_ERREUR_MEMOIRE, "grille de %zu voxels trop grande", nbVoxels);
+    *g = (Grille){ .largeur = largeur, .hauteur = hauteur, .profondeur = profondeur, .connexite = connexite };
+    g->source  = calloc(nbVoxels, sizeof *g->source);
+    g->puits   = calloc(nbVoxels, sizeof *g->puits);
+    g->voisins = calloc(nbVoxels * (size_t)connexite, sizeof *g->voisins);
+    if (!g->source || !g->puits || !g->voisins) {
+        libererGrille(g);
+        return fixerErreur(ctx, DINIC_ERREUR_MEMOIRE, "grille de %zu voxels trop grande", nbVoxels);
+    }
+    *res = g;
+    return DINIC_OK;
+}
+
+// ajoute c à *capa (lignes répétées : capacités cumulées, comme des arcs DIMACS parallèles)
+static bool cumulerCapacite(Capacite *capa, Capacite c) {
+    if (*capa > CAPACITE_MAX - c) return false;
+    *capa += c;
+    return true;
+}
+
+/***********************************************************************************************************/
+/* Action lireGrille :                                                                                     */
+/*   - fichier projeté en mémoire et lu séquentiellement ; format :                                        */
+/*       c <commentaire>                                                                                   */
+/*       p grille <largeur> <hauteur> <profondeur> <connexité>                                             */
+/*       t <x> <y> <z> <capacité source> <capacité puits>                                                  */
+/*       a <x> <y> <z> <dx> <dy> <dz> <capacité>     arc vers le voisin (x+dx, y+dy, z+dz)                 */
+/*   - coordonnées à partir de 0 ; capacités absentes nulles, lignes répétées cumulées                     */
+/*   - les lignes mal formées sont signalées avec leur numéro dans derniereErreur                          */
+/***********************************************************************************************************/
+DinicStatut lireGrille(Contexte *ctx, const char *chemin, Grille **res) {
+    *res = NULL;
+    ctx->erreur[0] = '\0';
+    double debut = maintenant();
+    int fd = open(chemin, O_RDONLY);
+    if (fd < 0) return fixerErreur(ctx, DINIC_ERREUR_FICHIER, "%s : %s", chemin, strerror(errno));
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return fixerErreur(ctx, DINIC_ERREUR_FICHIER, "%s : %s", chemin, strerror(errno));
+    }
+    size_t taille = (size_t)st.st_size;
+    const char *texte = NULL;
+    if (taille > 0) {
+        texte = mmap(NULL, taille, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (texte == MAP_FAILED) {
+            close(fd);
+            return fixerErreur(ctx, DINIC_ERREUR_FICHIER, "%s : mmap : %s", chemin, strerror(errno));
+        }
+        (void)madvise((void *)texte, taille, MADV_SEQUENTIAL);
+    }
+    close(fd);
+    const char *fin = texte + taille;
+    DinicStatut statut = DINIC_OK;
+    Grille *g = NULL;
+
+    // en-tête : commentaires puis ligne 'p grille'
+    int dims[4] = { 0, 0, 0, 0 };
+    long ligne = 1;
+    const char *p = texte;
+    for (; p < fin && !g; p = ligneSuivante(p, fin), ligne++) {
+        if (*p == 'c' || *p == '\n' || *p == '\r') continue;
+        LecteurDimacs l = { p + 1, fin };
+        sauterBlancs(&l);
+        bool valide = *p == 'p' && (size_t)(fin - l.p) > 6 && memcmp(l.p, "grille", 6) == 0 && estBlanc(l.p[6]);
+        if (valide) l.p += 6;
+        for (int i = 0; i < 4 && valide; i++) valide = lireEntier(&l, &dims[i]);
+        if (!valide || !finDeLigne(&l)) {
+            statut = fixerErreur(ctx, DINIC_ERREUR_FORMAT, "%s:%ld : ligne 'p' attendue "
+                                 "(p grille <largeur> <hauteur> <profondeur> <connexité>)", chemin, ligne);
+            goto fin;
+        }
+        statut = creerGrille(ctx, dims[0], dims[1], dims[2], dims[3], &g);
+        if (statut != DINIC_OK) {
+            if (statut == DINIC_ERREUR_PARAMETRE) statut = DINIC_ERREUR_FORMAT;
+            ajouterErreur(ctx, "%s:%ld : dimensions de grille invalides", chemin, ligne);
+            goto fin;
+        }
+    }
+    if (!g) {
+        statut = fixerErreur(ctx, DINIC_ERREUR_FORMAT, "%s : ligne 'p grille' manquante", chemin);
+        goto fin;
+    }
+
+    // rang de chaque déplacement (dx, dy, dz) de {-1, 0, 1}^3, -1 s'il n'est pas un voisin
+    int K = g->connexite, nbErreurs = 0, rang[27];
+    for (int i = 0; i < 27; i++) rang[i] = directionGrille(g, i % 3 - 1, i / 3 % 3 - 1, i / 9 - 1);
+    for (; p < fin; p = ligneSuivante(p, fin), ligne++) {
+        LecteurDimacs l = { p + 1, fin };
+        int c[6] = { 0, 0, 0, 0, 0, 0 };
+        Capacite capa[2] = { 0, 0 };
+        const char *msg = NULL;
+        switch (*p) {
+        case 't':
+        case 'a': {
+            int nbEntiers = (*p == 't') ? 3 : 6, nbCapa = (*p == 't') ? 2 : 1;
+            bool valide = true;
+            for (int i = 0; i < nbEntiers && valide; i++) {
+                int64_t v;
+                valide = lireNombre(&l, INT_MAX, &v) && v >= INT_MIN;
+                c[i] = (int)v;
+            }
+            for (int i = 0; i < nbCapa && valide; i++) valide = lireCapacite(&l, &capa[i]);
+            if (!valide || !finDeLigne(&l)) {
+                msg = (*p == 't') ? "ligne 't' mal formée (attendu : t <x> <y> <z> <source> <puits>)"
+                                  : "ligne 'a' mal formée (attendu : a <x> <y> <z> <dx> <dy> <dz> <capacité>)";
+                break;
+            }
+            if (c[0] < 0 || c[0] >= g->largeur || c[1] < 0 || c[1] >= g->hauteur || c[2] < 0 || c[2] >= g->profondeur) {
+                msg = "voxel hors de la grille";
+                break;
+            }
+            if (capa[0] < 0 || capa[1] < 0) {
+                msg = "capacité négative";
+                break;
+            }
+            size_t v = (size_t)c[0] + (size_t)g->largeur * ((size_t)c[1] + (size_t)g->hauteur * (size_t)c[2]);
+            if (*p == 't') {
+                if (!cumulerCapacite(&g->source[v], capa[0]) || !cumulerCapacite(&g->puits[v], capa[1])) {
+                    msg = "capacité cumulée trop grande";
+                }
+                break;
+            }
+            bool unite = c[3] >= -1 && c[3] <= 1 && c[4] >= -1 && c[4] <= 1 && c[5] >= -1 && c[5] <= 1;
+            int k = unite ? rang[(c[3] + 1) + 3 * (c[4] + 1) + 9 * (c[5] + 1)] : -1;
+            int x = c[0] + c[3], y = c[1] + c[4], z = c[2] + c[5];
+            if (k < 0) msg = "déplacement qui n'est pas un voisin pour cette connexité";
+            else if (x < 0 || x >= g->largeur || y < 0 || y >= g->hauteur || z < 0 || z >= g->profondeur) {
+                msg = "voisin hors de la grille";
+            } else if (!cumulerCapacite(&g->voisins[v * (size_t)K + (size_t)k], capa[0])) {
+                msg = "capacité cumulée trop grande";
+            }
+            break;
+        }
+        case 'c':
+        case '\n':
+        case '\r':
+            break;
+        case 'p':
+            msg = "ligne 'p' en double";
+            break;
+        default:
+            if (!finDeLigne(&(LecteurDimacs){ p, fin })) msg = "ligne non reconnue";
+            break;
+        }
+        if (msg) {
+            if (nbErreurs < DIMACS_MAX_ERREURS) ajouterErreur(ctx, "%s:%ld : %s", chemin, ligne, msg);
+            nbErreurs++;
+        }
+    }
+    if (nbErreurs > 0) {
+        if (nbErreurs > DIMACS_MAX_ERREURS) {
+            ajouterErreur(ctx, "%s : ... %d autres erreurs", chemin, nbErreurs - DIMACS_MAX_ERREURS);
+        }
+        ajouterErreur(ctx, "grille invalide: %d ligne(s) mal formée(s)", nbErreurs);
+        statut = DINIC_ERREUR_FORMAT;
+        goto fin;
+    }
+    *res = g;
+    g = NULL;
+
+fin:
+    libererGrille(g);
+    if (texte) munmap((void *)texte, taille);
+    ctx->stats.tempsChargement += maintenant() - debut;
+    return statut;
+}
+
+/***********************************************************************************************************/
+/* Action ecrireCoupeGrille :                                                                              */
+/*   - une ligne de l'image par rangée y de chaque tranche z, bits de poids fort en premier, ligne         */
+/*     complétée à l'octet                                                                                 */
+/***********************************************************************************************************/
+DinicStatut ecrireCoupeGrille(Contexte *ctx, const Grille *g, const uint64_t *coupe, const char *chemin) {
+    double debut = maintenant();
+    size_t octetsLigne = ((size_t)g->largeur + 7) / 8;
+    unsigned char *rangee = malloc(octetsLigne);
+    if (!rangee) return fixerErreur(ctx, DINIC_ERREUR_MEMOIRE, "allocation de %zu octets impossible", octetsLigne);
+    FILE *f = fopen(chemin, "wb");
+    if (!f) {
+        free(rangee);
+        return fixerErreur(ctx, DINIC_ERREUR_FICHIER, "impossible de créer le fichier %s : %s", chemin, strerror(errno));
+    }
+    fprintf(f, "P4\n# coupe minimale, 1 = côté source, %d tranche(s)\n%d %d\n",
+            g->profondeur, g->largeur, g->hauteur * g->profondeur);
+    size_t v = 0;
+    for (int r = 0; r < g->hauteur * g->profondeur; r++) {
+        memset(rangee, 0, octetsLigne);
+        for (int x = 0; x < g->largeur; x++, v++) {
+            if ((coupe[v >> 6] >> (v & 63)) & 1) rangee[x >> 3] |= (unsigned char)(0x80 >> (x & 7));
+        }
+        fwrite(rangee, 1, octetsLigne, f);
+    }
+    free(rangee);
+    if (fclose(f) != 0) {
+        return fixerErreur(ctx, DINIC_ERREUR_FICHIER, "écriture de %s : %s", chemin, strerror(errno));
+    }
+    ctx->stats.tempsEcriture += maintenant() - debut;
+    return DINIC_OK;
+}
+
+void libererGrille(Grille *g) {
+    if (!g) return;
+    free(g->source);
+    free(g->puits);
+    free(g->voisins);
+    free(g);
+}
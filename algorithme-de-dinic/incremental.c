@@ -0,0 +1,153 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include "dinic_interne.h"
+
+// -----------------------------------------------------------------------------
+// Flot maximal incrémental : modification de capacités sur une topologie fixe
+//
+// Le graphe résiduel d'un calcul précédent est conservé. Pour chaque arc e
+// (u->v) de flot f dont la capacité passe de c à c' :
+// - c' >= f : seule la capacité résiduelle directe change (c' - f) ;
+// - c' <  f : le flot de e est ramené à c', ce qui laisse un excédent
+//   eps = f - c' en u et un déficit eps en v. On tente d'abord de faire passer
+//   eps de u à v par d'autres chemins (le flot ne change pas), puis le reste est
+//   renvoyé de u vers la source et repris du puits vers v (le flot diminue).
+// Le moteur choisi reprend ensuite l'augmentation à partir de ce flot.
+// -----------------------------------------------------------------------------
+
+/***********************************************************************************************************/
+/* Action pousserChemins :                                                                                 */
+/*   - pousse au plus 'quantite' unités de a vers b par chemins augmentants successifs (BFS) dans rg       */
+/*   - parent, file : zones de travail de n cases ; st : statistiques (BFS, chemins, arcs parcourus)       */
+/*   - retourne : Capacite (quantité effectivement poussée)                                                */
+/***********************************************************************************************************/
+static Capacite pousserChemins(Graphe *rg, int a, int b, Capacite quantite, int *parent, int *file,
+                               Statistiques *st) {
+    Capacite pousse = 0;
+    while (pousse < quantite) {
+        st->nbBfs++;
+        for (int i = 0; i < rg->nbSommets; i++) parent[i] = -1;
+        int head = 0, tail = 0;
+        file[tail++] = a;
+        parent[a] = rg->debut[a];   // marque a comme atteint (valeur sans usage)
+        while (head < tail && parent[b] < 0) {
+            int w = file[head++];
+            st->arcsParcourus += rg->debut[w + 1] - rg->debut[w];
+            for (int e = rg->debut[w]; e < rg->debut[w + 1]; e++) {
+                int v = rg->SommetDest[e];
+                if (parent[v] < 0 && rg->capa[e] > 0) {
+                    parent[v] = e;
+                    file[tail++] = v;
+                }
+            }
+        }
+        if (parent[b] < 0) break;
+
+        Capacite k = quantite - pousse;
+        for (int v = b; v != a; v = rg->SommetDest[rg->inverse[parent[v]]]) {
+            if (rg->capa[parent[v]] < k) k = rg->capa[parent[v]];
+        }
+        for (int v = b; v != a; v = rg->SommetDest[rg->inverse[parent[v]]]) {
+            rg->capa[parent[v]] -= k;
+            rg->capa[rg->inverse[parent[v]]] += k;
+            st->longueurChemins++;
+        }
+        st->nbChemins++;
+        pousse += k;
+    }
+    return pousse;
+}
+
+/***********************************************************************************************************/
+/* Action reduireFlot :                                                                                    */
+/*   - ramène le flot de l'arc direct d (u->v) à sa nouvelle capacité et rétablit la conservation          */
+/*   - retourne : variation du flot sortant de la source, ou DINIC_ERREUR_PARAMETRE via *statut si         */
+/*     l'excédent ne peut être résorbé (graphe résiduel incohérent)                                        */
+/***********************************************************************************************************/
+static Capacite reduireFlot(Graphe *rg, int u, int d, Capacite capacite, int *parent, int *file,
+                            Statistiques *st, DinicStatut *statut) {
+    int r = rg->inverse[d], v = rg->SommetDest[d];
+    int s = rg->source, t = rg->puits;
+    Capacite eps = rg->capa[r] - capacite;
+    rg->capa[d] = 0;
+    rg->capa[r] = capacite;
+    if (u == v) return 0;
+
+    Capacite variation = (u == s) ? -eps : (v == s) ? eps : 0;
+    Capacite detour = pousserChemins(rg, u, v, eps, parent, file, st);
+    if (u == s) variation += detour;
+    if (v == s) variation -= detour;
+    eps -= detour;
+    if (eps == 0) return variation;
+
+    // excédent en u renvoyé à la source, déficit en v repris au puits
+    if (u != s && u != t) {
+        Capacite k = pousserChemins(rg, u, s, eps, parent, file, st);
+        variation -= k;
+        if (k != eps) *statut = DINIC_ERREUR_PARAMETRE;
+    }
+    if (v != s && v != t) {
+        Capacite k = pousserChemins(rg, t, v, eps, parent, file, st);
+        if (k != eps) *statut = DINIC_ERREUR_PARAMETRE;
+    }
+    return variation;
+}
+
+/***********************************************************************************************************/
+/* Action trouverArc :                                                                                     */
+/*   - cherche le premier arc u -> v du réseau initial (ordre du fichier DIMACS)                           */
+/***********************************************************************************************************/
+int trouverArc(const Graphe *g, int u, int v) {
+    if (u < 1 || u >= g->nbSommets) return -1;
+    for (int e = g->debut[u]; e < g->debut[u + 1]; e++) {
+        if (g->SommetDest[e] == v) return e;
+    }
+    return -1;
+}
+
+/***********************************************************************************************************/
+/* Action modifierCapacites :                                                                              */
+/*   - applique un lot de modifications (validé en entier avant toute modification), répare le flot des    */
+/*     arcs dont la capacité devient inférieure à leur flot puis reprend l'augmentation avec 'algo'        */
+/*   - le coût ne dépend que des arcs dont le flot doit être réparé et du flot restant à pousser           */
+/***********************************************************************************************************/
+DinicStatut modifierCapacites(Contexte *ctx, Graphe *g, Graphe *rg, const ModifCapacite *modifs, int nbModifs,
+                              Algorithme algo, Capacite *flot) {
+    ctx->erreur[0] = '\0';
+    if (!g->arcResiduel || rg->nbArcs != 2 * g->nbArcs) {
+        return fixerErreur(ctx, DINIC_ERREUR_PARAMETRE, "graphe résiduel sans lien avec le réseau");
+    }
+    for (int i = 0; i < nbModifs; i++) {
+        if (modifs[i].arc < 0 || modifs[i].arc >= g->nbArcs || modifs[i].capacite < 0) {
+            return fixerErreur(ctx, DINIC_ERREUR_PARAMETRE, "modification %d invalide (arc %d, capacité %lld)",
+                               i, modifs[i].arc, (long long)modifs[i].capacite);
+        }
+    }
+    size_t n = (size_t)rg->nbSommets;
+    int *parent = reserverTampon(ctx, T_NIVEAU, n * sizeof *parent);
+    int *file   = reserverTampon(ctx, T_FILE, n * sizeof *file);
+    if (!parent || !file) return DINIC_ERREUR_MEMOIRE;
+
+    DinicStatut statut = DINIC_OK;
+    Capacite valeur = *flot;
+    double debut = maintenant();
+    for (int i = 0; i < nbModifs; i++) {
+        int e = modifs[i].arc, d = g->arcResiduel[e];
+        Capacite c = modifs[i].capacite;
+        Capacite f = rg->capa[rg->inverse[d]];
+        g->capa[e] = c;
+        if (c >= f) rg->capa[d] = c - f;
+        else valeur += reduireFlot(rg, rg->SommetDest[rg->inverse[d]], d, c, parent, file, &ctx->stats,
+                                  &statut);
+    }
+    ctx->stats.tempsResolution += maintenant() - debut;
+    if (statut != DINIC_OK) {
+        return fixerErreur(ctx, statut, "réparation du flot impossible : graphe résiduel incohérent");
+    }
+
+    Capacite supplement = 0;
+    statut = resoudre(ctx, rg, algo, &supplement);
+    if (statut != DINIC_OK) return statut;
+    *flot = valeur + supplement;
+    return DINIC_OK;
+}
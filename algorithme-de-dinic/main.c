@@ -0,0 +1,326 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <time.h>
+#include "dinic.h"
+
+static double horloge(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+// chaîne JSON : guillemets, barres obliques inverses et caractères de contrôle échappés
+static void ecrireChaineJson(FILE *f, const char *s) {
+    fputc('"', f);
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') fprintf(f, "\\%c", c);
+        else if (c < 0x20) fprintf(f, "\\u%04x", c);
+        else fputc(c, f);
+    }
+    fputc('"', f);
+}
+
+/***********************************************************************************************************/
+/* Action ecrireStatistiques :                                                                             */
+/*   - rapport JSON d'une exécution (--stats) : instance, algorithme, flot, temps par étape, compteurs     */
+/*     et pic mémoire, sur une seule ligne pour être ajouté tel quel à un journal                          */
+/***********************************************************************************************************/
+static void ecrireStatistiques(FILE *f, Contexte *ctx, const char *fichier, const char *algo, int nbThreads,
+                               int64_t sommets, int64_t arcs, DinicStatut statut, Capacite flot, double total) {
+    const Statistiques *st = statistiques(ctx);
+    fprintf(f, "{\"instance\":");
+    ecrireChaineJson(f, fichier);
+    fprintf(f, ",\"algo\":\"%s\",\"threads\":%d,\"statut\":", algo, nbThreads);
+    ecrireChaineJson(f, texteStatut(statut));
+    fprintf(f, ",\"sommets\":%" PRId64 ",\"arcs\":%" PRId64 ",\"flot\":%" PRId64 ",", sommets, arcs, flot);
+    fprintf(f, "\"temps_s\":{\"chargement\":%.6f,\"reduction\":%.6f,\"residuel\":%.6f,\"resolution\":%.6f,"
+               "\"bfs\":%.6f,\"augmentation\":%.6f,\"ecriture\":%.6f,\"total\":%.6f},",
+            st->tempsChargement, st->tempsReduction, st->tempsResiduel, st->tempsResolution,
+            st->tempsBfs, st->tempsAugmentation, st->tempsEcriture, total);
+    fprintf(f, "\"compteurs\":{\"bfs\":%" PRId64 ",\"chemins\":%" PRId64 ",\"longueur_moyenne\":%.2f,"
+               "\"poussees\":%" PRId64 ",\"reetiquetages\":%" PRId64 ",\"arcs_parcourus\":%" PRId64 "},",
+            st->nbBfs, st->nbChemins,
+            st->nbChemins ? (double)st->longueurChemins / (double)st->nbChemins : 0.0,
+            st->nbPoussees, st->nbReetiquetages, st->arcsParcourus);
+    fprintf(f, "\"memoire_pic_ko\":%ld}\n", st->memoirePicKo);
+}
+
+/***********************************************************************************************************/
+/* Action appliquerModifications :                                                                         */
+/*   - lit un fichier de lots de modifications et recalcule le flot à chaud après chaque lot :             */
+/*       c <commentaire>                                                                                   */
+/*       m <u> <v> <capacité>   nouvelle capacité du premier arc u -> v                                    */
+/*       r                      fin de lot : recalcul et affichage du flot (implicite en fin de fichier)   */
+/*   - paramètres : Contexte* ctx, Graphe* g, Graphe* rg, Algorithme algo, const char* chemin,             */
+/*                  Capacite* flot (flot courant, mis à jour)                                              */
+/*   - retourne : DINIC_OK ou le code d'erreur (message affiché)                                           */
+/***********************************************************************************************************/
+static DinicStatut appliquerModifications(Contexte *ctx, Graphe *g, Graphe *rg, Algorithme algo,
+                                          const char *chemin, Capacite *flot) {
+    FILE *f = fopen(chemin, "r");
+    if (!f) {
+        perror(chemin);
+        return DINIC_ERREUR_FICHIER;
+    }
+    ModifCapacite *lot = NULL;
+    int nbModifs = 0, capaLot = 0, numLot = 0;
+    long ligne = 0;
+    char buf[256];
+    DinicStatut statut = DINIC_OK;
+    bool fin = false;
+    while (statut == DINIC_OK && !fin) {
+        fin = (fgets(buf, sizeof buf, f) == NULL);
+        if (!fin) ligne++;
+        if (fin || buf[0] == 'r') {
+            if (fin && nbModifs == 0) break;
+            statut = modifierCapacites(ctx, g, rg, lot, nbModifs, algo, flot);
+            if (statut != DINIC_OK) break;
+            printf("Lot %d (%d modification(s)) : flot maximal %" PRId64 "\n", ++numLot, nbModifs, *flot);
+            nbModifs = 0;
+        } else if (buf[0] == 'm') {
+            int u, v;
+            int64_t c;
+            int e = -1;
+            if (sscanf(buf + 1, "%d %d %" SCNd64, &u, &v, &c) != 3 || c < 0 || (e = trouverArc(g, u, v)) < 0) {
+                fprintf(stderr, "%s:%ld : modification invalide ou arc inexistant\n", chemin, ligne);
+                statut = DINIC_ERREUR_PARAMETRE;
+                break;
+            }
+            if (nbModifs == capaLot) {
+                capaLot = capaLot ? 2 * capaLot : 64;
+                ModifCapacite *p = realloc(lot, (size_t)capaLot * sizeof *lot);
+                if (!p) { statut = DINIC_ERREUR_MEMOIRE; break; }
+                lot = p;
+            }
+            lot[nbModifs++] = (ModifCapacite){ .arc = e, .capacite = c };
+        } else if (buf[0] != 'c' && buf[0] != '\n' && buf[0] != '\r') {
+            fprintf(stderr, "%s:%ld : ligne non reconnue\n", chemin, ligne);
+            statut = DINIC_ERREUR_PARAMETRE;
+        }
+    }
+    free(lot);
+    fclose(f);
+    return statut;
+}
+
+/***********************************************************************************************************/
+/* Action repondrePaires :                                                                                 */
+/*   - lit des paires "u v" (une par ligne, lignes 'c' ignorées) et affiche leur coupe minimale            */
+/*     d'après l'arbre de Gomory-Hu                                                                        */
+/*   - retourne : DINIC_OK ou le code d'erreur (message affiché)                                           */
+/***********************************************************************************************************/
+static DinicStatut repondrePaires(const ArbreCoupes *arbre, const char *chemin) {
+    FILE *f = fopen(chemin, "r");
+    if (!f) {
+        perror(chemin);
+        return DINIC_ERREUR_FICHIER;
+    }
+    long ligne = 0;
+    char buf[256];
+    DinicStatut statut = DINIC_OK;
+    while (statut == DINIC_OK && fgets(buf, sizeof buf, f)) {
+        ligne++;
+        int u, v;
+        if (buf[0] == 'c' || buf[0] == '\n' || buf[0] == '\r') continue;
+        Capacite k = -1;
+        if (sscanf(buf, "%d %d", &u, &v) != 2 || (k = coupeMinimale(arbre, u, v)) < 0) {
+            fprintf(stderr, "%s:%ld : paire invalide ou sommet inexistant\n", chemin, ligne);
+            statut = DINIC_ERREUR_PARAMETRE;
+        } else if (u == v) {
+            printf("Coupe minimale %d - %d : infinie\n", u, v);
+        } else {
+            printf("Coupe minimale %d - %d : %" PRId64 "\n", u, v, k);
+        }
+    }
+    fclose(f);
+    return statut;
+}
+
+/***********************************************************************************************************/
+/* Action resoudreGrille :                                                                                 */
+/*   - lit une grille implicite, calcule son flot par Boykov-Kolmogorov et écrit le flot maximal dans      */
+/*     'resultat' et la coupe minimale en image PBM dans 'image'                                           */
+/*   - paramètres : ..., Capacite* flot, int64_t* voxels, int64_t* arcs (taille pour --stats)              */
+/*   - retourne : DINIC_OK ou le code d'erreur                                                             */
+/***********************************************************************************************************/
+static DinicStatut resoudreGrille(Contexte *ctx, const char *fichier, const char *image, const char *resultat,
+                                  Capacite *flot, int64_t *voxels, int64_t *arcs) {
+    Grille *g = NULL;
+    uint64_t *coupe = NULL;
+    DinicStatut statut = lireGrille(ctx, fichier, &g);
+    if (statut == DINIC_OK) {
+        *voxels = (int64_t)g->largeur * g->hauteur * g->profondeur;
+        *arcs = *voxels * g->connexite;
+        coupe = calloc(((size_t)*voxels + 63) / 64, sizeof *coupe);
+        if (!coupe) statut = DINIC_ERREUR_MEMOIRE;
+    }
+    if (statut == DINIC_OK) statut = flotGrille(ctx, g, flot, coupe);
+    if (statut == DINIC_OK) statut = ecrireCoupeGrille(ctx, g, coupe, image);
+    if (statut == DINIC_OK) {
+        int64_t cote = 0;
+        for (size_t i = 0; i < ((size_t)*voxels + 63) / 64; i++) cote += __builtin_popcountll(coupe[i]);
+        FILE *f = fopen(resultat, "w");
+        if (!f) statut = DINIC_ERREUR_FICHIER;
+        else {
+            fprintf(f, "Flot maximal : %" PRId64 "\n", *flot);
+            fprintf(f, "\nCoupe minimale : %" PRId64 " voxel(s) sur %" PRId64 " côté source (image %s)\n",
+                    cote, *voxels, image);
+            if (fclose(f) != 0) statut = DINIC_ERREUR_FICHIER;
+        }
+    }
+    free(coupe);
+    libererGrille(g);
+    return statut;
+}
+
+/***********************************************************************************************************/
+/* main :                                                                                                  */
+/*   - interface en ligne de commande de libdinic : lit le fichier DIMACS, exécute l'algorithme choisi     */
+/*     (Dinic par défaut) et écrit le résultat                                                             */
+/*   - les flots du réseau initial sont relus une seule fois dans le graphe résiduel final                 */
+/*   - --save-binary=F enregistre le réseau lu dans le cache binaire F ; --load-binary lit un tel cache    */
+/*     à la place du fichier DIMACS                                                                        */
+/*   - --edits=F applique ensuite les lots de modifications de F en reprenant le flot précédent            */
+/*   - --reduce résout un réseau réduit équivalent (élagage, arcs parallèles, chaînes) puis reporte les    */
+/*     flots sur tous les arcs du réseau lu                                                                */
+/*   - --gomory-hu écrit l'arbre de Gomory-Hu du réseau non orienté au lieu du flot ; --paires=F affiche   */
+/*     en plus la coupe minimale de chaque paire de F                                                      */
+/*   - --grille lit une grille implicite (format de lireGrille) et la résout par Boykov-Kolmogorov sans    */
+/*     graphe CSR ; la coupe minimale est écrite en image PBM dans coupe.pbm ou le fichier de --coupe=F    */
+/*   - --sortie=binaire écrit les flux des arcs en binaire, --sortie=coupe seulement la coupe minimale ;   */
+/*     --resultat=F remplace le fichier résultat (resultat.txt, ou resultat.bin en binaire)                */
+/*   - --stats écrit sur la sortie standard un rapport JSON (temps par étape, compteurs, pic mémoire)      */
+/*   - paramètres : argc, argv ([--algo=...] [--threads=N] [--save-binary=F] [--load-binary] [--edits=F]   */
+/*                  [--reduce] [--gomory-hu] [--paires=F] [--grille] [--coupe=F] [--sortie=M]              */
+/*                  [--resultat=F] [--stats] fichier)                                                      */
+/***********************************************************************************************************/
+int main(int argc, char **argv) {
+    double debutTotal = horloge();
+    static const struct { const char *nom; Algorithme algo; } algos[] = {
+        { "dinic", ALGO_DINIC }, { "scaling", ALGO_SCALING },
+        { "hipr", ALGO_HIPR }, { "parallel", ALGO_PARALLELE }, { "bk", ALGO_BK },
+    };
+    static const struct { const char *nom; ModeSortie mode; } sorties[] = {
+        { "texte", SORTIE_TEXTE }, { "binaire", SORTIE_BINAIRE }, { "coupe", SORTIE_COUPE },
+    };
+    const char *fichier = NULL, *nomAlgo = NULL, *cache = NULL, *modifs = NULL, *paires = NULL;
+    const char *image = "coupe.pbm", *resultat = NULL;
+    int nbThreads = 0, sortie = 0;
+    bool usage = false, binaire = false, stats = false, arbreGH = false, reduire = false, grille = false;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--algo=", 7) == 0) nomAlgo = argv[i] + 7;
+        else if (strncmp(argv[i], "--threads=", 10) == 0) {
+            nbThreads = atoi(argv[i] + 10);
+            if (nbThreads < 1) usage = true;
+        }
+        else if (strncmp(argv[i], "--save-binary=", 14) == 0 && argv[i][14]) cache = argv[i] + 14;
+        else if (strcmp(argv[i], "--load-binary") == 0) binaire = true;
+        else if (strncmp(argv[i], "--edits=", 8) == 0 && argv[i][8]) modifs = argv[i] + 8;
+        else if (strcmp(argv[i], "--reduce") == 0) reduire = true;
+        else if (strcmp(argv[i], "--gomory-hu") == 0) arbreGH = true;
+        else if (strncmp(argv[i], "--paires=", 9) == 0 && argv[i][9]) paires = argv[i] + 9, arbreGH = true;
+        else if (strcmp(argv[i], "--grille") == 0) grille = true;
+        else if (strncmp(argv[i], "--coupe=", 8) == 0 && argv[i][8]) image = argv[i] + 8;
+        else if (strncmp(argv[i], "--sortie=", 9) == 0) {
+            sortie = -1;
+            for (int k = 0; k < (int)(sizeof sorties / sizeof sorties[0]); k++) {
+                if (strcmp(argv[i] + 9, sorties[k].nom) == 0) sortie = k;
+            }
+            if (sortie < 0) usage = true;
+        }
+        else if (strncmp(argv[i], "--resultat=", 11) == 0 && argv[i][11]) resultat = argv[i] + 11;
+        else if (strcmp(argv[i], "--stats") == 0) stats = true;
+        else if (argv[i][0] != '-' && !fichier) fichier = argv[i];
+        else usage = true;
+    }
+    if (!nomAlgo) nomAlgo = grille ? "bk" : "dinic";
+    int choix = -1;
+    for (int i = 0; i < (int)(sizeof algos / sizeof algos[0]); i++) {
+        if (strcmp(nomAlgo, algos[i].nom) == 0) choix = i;
+    }
+    // une grille n'a pas de graphe CSR : seul Boykov-Kolmogorov s'y applique
+    if (grille && (cache || binaire || strcmp(nomAlgo, "bk") != 0)) usage = true;
+    // l'arbre de Gomory-Hu et la grille ont leur propre résultat texte
+    if ((grille || arbreGH) && sortie > 0) usage = true;
+    if (!resultat) resultat = (sortie >= 0 && sorties[sortie].mode == SORTIE_BINAIRE) ? "resultat.bin" : "resultat.txt";
+    if (usage || !fichier || choix < 0 || (arbreGH + (modifs != NULL) + reduire + grille > 1)) {
+        fprintf(stderr, "Usage: %s [--algo=dinic|scaling|hipr|parallel|bk] [--threads=N] "
+                        "[--save-binary=<cache>] [--load-binary] [--edits=<lots> | --reduce | --gomory-hu [--paires=<paires>]] "
+                        "[--sortie=texte|binaire|coupe] [--resultat=<fichier>] [--stats] <DIMACS|cache>\n"
+                        "       %s --grille [--coupe=<image.pbm>] [--resultat=<fichier>] [--stats] <grille>\n",
+                argv[0], argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    Contexte *ctx = creerContexte();
+    if (!ctx) {
+        fprintf(stderr, "Erreur d'allocation memoire\n");
+        return EXIT_FAILURE;
+    }
+    definirThreads(ctx, nbThreads);
+    Graphe *network = NULL, *resGraph = NULL, *reduit = NULL;
+    Reduction *reduction = NULL;
+    ArbreCoupes *arbre = NULL;
+    Capacite maxFlow = 0;
+    int64_t sommets = 0, arcs = 0;
+    DinicStatut statut = DINIC_OK;
+    if (!grille) {
+        statut = binaire ? lireGrapheBinaire(ctx, fichier, &network) : buildGraph(ctx, fichier, &network);
+    }
+    if (statut == DINIC_OK && cache) statut = ecrireGrapheBinaire(ctx, network, cache);
+    if (network) sommets = network->nbSommets - 1, arcs = network->nbArcs;
+    if (grille) {
+        statut = resoudreGrille(ctx, fichier, image, resultat, &maxFlow, &sommets, &arcs);
+    } else if (arbreGH) {
+        if (statut == DINIC_OK) statut = gomoryHu(ctx, network, algos[choix].algo, &arbre);
+        if (statut == DINIC_OK) statut = ecrireArbreCoupes(ctx, arbre, resultat);
+        if (statut == DINIC_OK && paires) statut = repondrePaires(arbre, paires);
+    } else if (reduire) {
+        if (statut == DINIC_OK) statut = reduireGraphe(ctx, network, &reduit, &reduction);
+        if (statut == DINIC_OK) statut = buildResidualGraph(ctx, reduit, &resGraph);
+        if (statut == DINIC_OK) statut = resoudre(ctx, resGraph, algos[choix].algo, &maxFlow);
+        if (statut == DINIC_OK) {
+            if (!stats) {
+                printf("Réseau réduit : %d sommets, %d arcs (au lieu de %d sommets, %d arcs)\n",
+                       reduit->nbSommets - 1, reduit->nbArcs, network->nbSommets - 1, network->nbArcs);
+            }
+            updateNetworkFlow(resGraph, reduit);
+            restaurerFlots(reduction, reduit, network);
+            statut = ecrireResultat(ctx, network, maxFlow, resultat, sorties[sortie].mode);
+        }
+    } else {
+        if (statut == DINIC_OK) statut = buildResidualGraph(ctx, network, &resGraph);
+        if (statut == DINIC_OK) statut = resoudre(ctx, resGraph, algos[choix].algo, &maxFlow);
+        if (statut == DINIC_OK && modifs) {
+            printf("Flot initial : %" PRId64 "\n", maxFlow);
+            statut = appliquerModifications(ctx, network, resGraph, algos[choix].algo, modifs, &maxFlow);
+        }
+        if (statut == DINIC_OK) {
+            updateNetworkFlow(resGraph, network);
+            statut = ecrireResultat(ctx, network, maxFlow, resultat, sorties[sortie].mode);
+        }
+    }
+    if (stats) {
+        ecrireStatistiques(stdout, ctx, fichier, nomAlgo, nbThreads, sommets, arcs, statut, maxFlow,
+                           horloge() - debutTotal);
+    }
+    if (statut == DINIC_OK) {
+        if (!stats) printf("Résultat écrit dans le fichier %s\n", resultat);
+    } else if (derniereErreur(ctx)[0] != '\0') {
+        fprintf(stderr, "Erreur : %s\n", derniereErreur(ctx));
+    } else {
+        fprintf(stderr, "Erreur : %s\n", texteStatut(statut));
+    }
+    libererArbreCoupes(arbre);
+    libererReduction(reduction);
+    freeGraph(reduit);
+    freeGraph(resGraph);
+    freeGraph(network);
+    libererContexte(ctx);
+    return (statut == DINIC_OK) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
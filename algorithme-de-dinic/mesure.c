@@ -0,0 +1,41 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+// -----------------------------------------------------------------------------
+// Mesure du temps et de la mémoire d'une commande
+//
+// UTILISATION : ./mesure <commande> [arguments...]
+//   - exécute la commande (sortie standard redirigée vers /dev/null)
+//   - écrit sur la sortie standard "temps_s,rss_ko" : temps écoulé et pic de
+//     mémoire résidente du processus fils (getrusage via wait4)
+//   - le code de retour est celui de la commande
+// -----------------------------------------------------------------------------
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <commande> [arguments...]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    struct timespec debut, fin;
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    pid_t pid = fork();
+    if (pid < 0) { perror("fork"); return EXIT_FAILURE; }
+    if (pid == 0) {
+        if (!freopen("/dev/null", "w", stdout)) _exit(127);
+        execvp(argv[1], argv + 1);
+        perror(argv[1]);
+        _exit(127);
+    }
+    int etat;
+    struct rusage usage;
+    if (wait4(pid, &etat, 0, &usage) < 0) { perror("wait4"); return EXIT_FAILURE; }
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    double temps = (double)(fin.tv_sec - debut.tv_sec) + (double)(fin.tv_nsec - debut.tv_nsec) * 1e-9;
+    printf("%.3f,%ld\n", temps, usage.ru_maxrss);
+    return WIFEXITED(etat) ? WEXITSTATUS(etat) : EXIT_FAILURE;
+}
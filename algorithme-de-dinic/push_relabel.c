@@ -0,0 +1,509 @@
+#define _DEFAULT_SOURCE
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
+#include <pthread.h>
+#include "dinic_interne.h"
+
+// -----------------------------------------------------------------------------
+// Push-relabel « highest label » (variante HIPR de Cherkassky et Goldberg)
+//
+// - PushRelabel       : étiquettes, excédents et seaux de sommets par étiquette.
+//   - actif*          : seaux des sommets actifs (excédent > 0), simplement chaînés.
+//   - tous*           : seaux de tous les sommets étiquetés < n, doublement chaînés
+//                       pour l'heuristique du trou (gap).
+// - Une passe pousse l'excédent vers 'cible' sans jamais traverser 'exclu' :
+//   - passe 1 : cible = puits, exclu = source -> préflot maximal
+//   - passe 2 : cible = source, exclu = puits -> l'excédent restant est renvoyé
+//               à la source, le préflot devient un flot (flux par arc valides)
+// -----------------------------------------------------------------------------
+#define HIPR_ALPHA 6   // ré-étiquetage global après ALPHA*n + m unités de travail
+
+typedef struct {
+    Graphe *rg;
+    int  n;
+    int *d;          // étiquette (distance estimée à la cible), n = hors d'atteinte
+    Capacite *excedent;
+    int *courant;    // arc courant de chaque sommet
+    int *actifTete, *actifSuiv;
+    int *tousTete, *tousSuiv, *tousPrec;
+    int  dmaxActif, dmaxTous;
+    int  cible, exclu;
+    long travail;    // travail de ré-étiquetage depuis le dernier ré-étiquetage global
+    int *file;
+    int64_t poussees, reetiquetages, arcs, nbGlobal;   // statistiques
+    double  tempsGlobal;
+} PushRelabel;
+
+static void prAjouterActif(PushRelabel *pr, int v) {
+    int dv = pr->d[v];
+    pr->actifSuiv[v] = pr->actifTete[dv];
+    pr->actifTete[dv] = v;
+    if (dv > pr->dmaxActif) pr->dmaxActif = dv;
+}
+
+static void prAjouterTous(PushRelabel *pr, int v) {
+    int dv = pr->d[v];
+    pr->tousPrec[v] = -1;
+    pr->tousSuiv[v] = pr->tousTete[dv];
+    if (pr->tousTete[dv] >= 0) pr->tousPrec[pr->tousTete[dv]] = v;
+    pr->tousTete[dv] = v;
+    if (dv > pr->dmaxTous) pr->dmaxTous = dv;
+}
+
+static void prRetirerTous(PushRelabel *pr, int v) {
+    if (pr->tousPrec[v] >= 0) pr->tousSuiv[pr->tousPrec[v]] = pr->tousSuiv[v];
+    else pr->tousTete[pr->d[v]] = pr->tousSuiv[v];
+    if (pr->tousSuiv[v] >= 0) pr->tousPrec[pr->tousSuiv[v]] = pr->tousPrec[v];
+}
+
+/***********************************************************************************************************/
+/* Action prGlobalRelabel :                                                                                */
+/*   - BFS inverse depuis la cible sur les arcs résiduels : d[v] = distance exacte de v à la cible         */
+/*   - les sommets qui n'atteignent plus la cible reçoivent l'étiquette n et sortent de la passe           */
+/*   - reconstruit les seaux et remet les arcs courants au début                                           */
+/***********************************************************************************************************/
+static void prGlobalRelabel(PushRelabel *pr) {
+    const Graphe *rg = pr->rg;
+    int n = pr->n;
+    double debut = maintenant();
+    for (int v = 0; v < n; v++) {
+        pr->d[v] = n;
+        pr->actifTete[v] = pr->tousTete[v] = -1;
+        pr->courant[v] = rg->debut[v];
+    }
+    pr->dmaxActif = pr->dmaxTous = -1;
+
+    int head = 0, tail = 0;
+    pr->d[pr->cible] = 0;
+    pr->file[tail++] = pr->cible;
+    while (head < tail) {
+        int w = pr->file[head++];
+        prAjouterTous(pr, w);
+        if (pr->excedent[w] > 0 && w != pr->cible) prAjouterActif(pr, w);
+        pr->arcs += rg->debut[w + 1] - rg->debut[w];
+        for (int e = rg->debut[w]; e < rg->debut[w + 1]; e++) {
+            int v = rg->SommetDest[e];
+            if (pr->d[v] == n && v != pr->exclu && rg->capa[rg->inverse[e]] > 0) {
+                pr->d[v] = pr->d[w] + 1;
+                pr->file[tail++] = v;
+            }
+        }
+    }
+    pr->travail = 0;
+    pr->nbGlobal++;
+    pr->tempsGlobal += maintenant() - debut;
+}
+
+/***********************************************************************************************************/
+/* Action prGap :                                                                                          */
+/*   - heuristique du trou : plus aucun sommet d'étiquette k, donc les sommets d'étiquette > k ne peuvent  */
+/*     plus atteindre la cible ; ils reçoivent l'étiquette n et quittent la passe                          */
+/***********************************************************************************************************/
+static void prGap(PushRelabel *pr, int k) {
+    for (int l = k + 1; l <= pr->dmaxTous; l++) {
+        for (int v = pr->tousTete[l]; v >= 0; v = pr->tousSuiv[v]) pr->d[v] = pr->n;
+        pr->tousTete[l] = -1;
+        pr->actifTete[l] = -1;
+    }
+    pr->dmaxTous = k - 1;
+    if (pr->dmaxActif > pr->dmaxTous) pr->dmaxActif = pr->dmaxTous;
+}
+
+/***********************************************************************************************************/
+/* Action prDecharger :                                                                                    */
+/*   - pousse l'excédent de u sur les arcs admissibles (capacité > 0, d[v] == d[u] - 1) à partir de        */
+/*     l'arc courant ; quand aucun arc ne convient, ré-étiquette u (ou applique le trou)                   */
+/***********************************************************************************************************/
+static void prDecharger(PushRelabel *pr, int u) {
+    Graphe *rg = pr->rg;
+    int n = pr->n;
+    while (pr->excedent[u] > 0) {
+        int fin = rg->debut[u + 1];
+        int e = pr->courant[u];
+        int e0 = e;
+        for (; e < fin; e++) {
+            int v = rg->SommetDest[e];
+            if (rg->capa[e] > 0 && pr->d[v] == pr->d[u] - 1) {
+                pr->poussees++;
+                Capacite k = (pr->excedent[u] < rg->capa[e]) ? pr->excedent[u] : rg->capa[e];
+                rg->capa[e] -= k;
+                rg->capa[rg->inverse[e]] += k;
+                if (pr->excedent[v] == 0 && v != pr->cible && v != pr->exclu) prAjouterActif(pr, v);
+                pr->excedent[v] += k;
+                pr->excedent[u] -= k;
+                if (pr->excedent[u] == 0) break;
+            }
+        }
+        pr->courant[u] = e;
+        pr->arcs += e - e0 + (e < fin);
+        if (pr->excedent[u] == 0) break;
+
+        // ré-étiquetage : plus petite étiquette voisine + 1
+        int ancien = pr->d[u], nouveau = n;
+        for (int a = rg->debut[u]; a < fin; a++) {
+            if (rg->capa[a] > 0 && pr->d[rg->SommetDest[a]] + 1 < nouveau) {
+                nouveau = pr->d[rg->SommetDest[a]] + 1;
+            }
+        }
+        pr->travail += HIPR_ALPHA + (fin - rg->debut[u]);
+        pr->reetiquetages++;
+        pr->arcs += fin - rg->debut[u];
+        prRetirerTous(pr, u);
+        if (pr->tousTete[ancien] < 0) {
+            pr->d[u] = n;
+            prGap(pr, ancien);
+            break;
+        }
+        pr->d[u] = nouveau;
+        if (nouveau >= n) break;
+        pr->courant[u] = rg->debut[u];
+        prAjouterTous(pr, u);
+    }
+}
+
+/***********************************************************************************************************/
+/* Action prPasse :                                                                                        */
+/*   - traite toujours un sommet actif d'étiquette maximale jusqu'à ce qu'il n'en reste plus               */
+/*   - ré-étiquetage global au départ puis dès que le travail dépasse ALPHA*n + m                          */
+/***********************************************************************************************************/
+static void prPasse(PushRelabel *pr, int cible, int exclu) {
+    pr->cible = cible;
+    pr->exclu = exclu;
+    long seuil = (long)HIPR_ALPHA * pr->n + pr->rg->nbArcs;
+    prGlobalRelabel(pr);
+    while (pr->dmaxActif >= 0) {
+        int u = pr->actifTete[pr->dmaxActif];
+        if (u < 0) { pr->dmaxActif--; continue; }
+        pr->actifTete[pr->dmaxActif] = pr->actifSuiv[u];
+        if (pr->d[u] >= pr->n || pr->excedent[u] == 0) continue;
+        prDecharger(pr, u);
+        if (pr->travail > seuil) prGlobalRelabel(pr);
+    }
+}
+
+/***********************************************************************************************************/
+/* Action prInit :                                                                                         */
+/*   - prend les tableaux de travail du push-relabel dans le contexte et sature les arcs sortant de la     */
+/*     source                                                                                              */
+/*   - retourne : DINIC_OK ou DINIC_ERREUR_MEMOIRE                                                         */
+/***********************************************************************************************************/
+static DinicStatut prInit(Contexte *ctx, PushRelabel *pr, Graphe *rg) {
+    int n = rg->nbSommets;
+    size_t taille = (size_t)n * sizeof(int);
+    *pr = (PushRelabel){ .rg = rg, .n = n };
+    pr->d         = reserverTampon(ctx, T_D, taille);
+    pr->excedent  = reserverTampon(ctx, T_EXCEDENT, (size_t)n * sizeof *pr->excedent);
+    pr->courant   = reserverTampon(ctx, T_COURANT, taille);
+    pr->actifTete = reserverTampon(ctx, T_ACTIF_TETE, taille);
+    pr->actifSuiv = reserverTampon(ctx, T_ACTIF_SUIV, taille);
+    pr->tousTete  = reserverTampon(ctx, T_TOUS_TETE, taille);
+    pr->tousSuiv  = reserverTampon(ctx, T_TOUS_SUIV, taille);
+    pr->tousPrec  = reserverTampon(ctx, T_TOUS_PREC, taille);
+    pr->file      = reserverTampon(ctx, T_FILE, taille);
+    if (!pr->d || !pr->excedent || !pr->courant || !pr->actifTete || !pr->actifSuiv ||
+        !pr->tousTete || !pr->tousSuiv || !pr->tousPrec || !pr->file) {
+        return DINIC_ERREUR_MEMOIRE;
+    }
+
+    for (int v = 0; v < n; v++) pr->excedent[v] = 0;
+    int s = rg->source;
+    for (int e = rg->debut[s]; e < rg->debut[s + 1]; e++) {
+        Capacite k = rg->capa[e];
+        if (k > 0 && rg->SommetDest[e] != s) {
+            rg->capa[e] = 0;
+            rg->capa[rg->inverse[e]] += k;
+            pr->excedent[rg->SommetDest[e]] += k;
+        }
+    }
+    return DINIC_OK;
+}
+
+/***********************************************************************************************************/
+/* Action prBilan :                                                                                        */
+/*   - ajoute les compteurs du push-relabel aux statistiques du contexte ; le temps hors ré-étiquetages    */
+/*     globaux est compté comme temps d'augmentation                                                       */
+/***********************************************************************************************************/
+static void prBilan(Contexte *ctx, const PushRelabel *pr, double duree) {
+    Statistiques *st = &ctx->stats;
+    st->nbBfs += pr->nbGlobal;
+    st->tempsBfs += pr->tempsGlobal;
+    st->tempsAugmentation += duree - pr->tempsGlobal;
+    st->nbPoussees += pr->poussees;
+    st->nbReetiquetages += pr->reetiquetages;
+    st->arcsParcourus += pr->arcs;
+}
+
+/***********************************************************************************************************/
+/* Action pushRelabel :                                                                                    */
+/*   - flot maximal par push-relabel « highest label » avec ré-étiquetage global et heuristique du trou    */
+/*   - sature les arcs sortant de la source, calcule un préflot maximal (passe 1) puis renvoie l'excédent  */
+/*     restant vers la source (passe 2) pour que le graphe résiduel décrive un flot                        */
+/*   - paramètres : Contexte* ctx, Graphe* rg (graphe résiduel, modifié en place), Capacite* flot          */
+/*   - retourne : DINIC_OK ou DINIC_ERREUR_MEMOIRE                                                         */
+/***********************************************************************************************************/
+DinicStatut pushRelabel(Contexte *ctx, Graphe *rg, Capacite *flot) {
+    double debut = maintenant();
+    PushRelabel pr;
+    DinicStatut statut = prInit(ctx, &pr, rg);
+    if (statut != DINIC_OK) return statut;
+    prPasse(&pr, rg->puits, rg->source);
+    *flot = pr.excedent[rg->puits];
+    prPasse(&pr, rg->source, rg->puits);
+    prBilan(ctx, &pr, maintenant() - debut);
+    return DINIC_OK;
+}
+
+// -----------------------------------------------------------------------------
+// Push-relabel multithread sans verrou (algorithme de Hong et He)
+//
+// - Chaque sommet actif appartient à un seul thread à la fois : il n'entre dans
+//   une file que si son drapeau enFile passe de 0 à 1 (compare-and-swap).
+// - Seul le propriétaire de u diminue excedent[u], modifie d[u] et diminue la
+//   capacité des arcs sortant de u ; les autres threads ne font qu'augmenter
+//   excedent[u] et capa[e] par des additions atomiques. Une lecture périmée est
+//   donc toujours une sous-estimation, ce qui rend la poussée sûre.
+// - Les threads avancent par tours : tous vident la file du tour courant et
+//   remplissent celle du tour suivant ; entre deux tours, si assez de
+//   ré-étiquetages ont eu lieu, tous les threads font ensemble un BFS inverse
+//   par niveaux depuis le puits (ré-étiquetage global concurrent).
+// - Les threads ne démarrent qu'une fois tous créés (porte mutex + condition) :
+//   si le système en refuse, la barrière est dimensionnée sur ceux qui existent
+//   et le calcul continue avec moins de threads.
+// - La passe 2 (retour de l'excédent à la source) reste séquentielle.
+// -----------------------------------------------------------------------------
+#define PPR_MAX_THREADS 256
+
+typedef struct {
+    PushRelabel *pr;           // tableaux d, excedent partagés avec la passe séquentielle
+    int   nbThreads;
+    unsigned char *enFile;     // 1 si le sommet est dans une file
+    int  *file[2];             // file du tour courant / du tour suivant
+    int   taille[2];           // atomique : nombre de sommets dans chaque file
+    int   tete;                // atomique : prochain indice à retirer de la file courante
+    int   courante;
+    int  *frontiere[2];        // BFS parallèle du ré-étiquetage global
+    int   tailleFrontiere[2];  // atomique
+    long  relabels;            // atomique : ré-étiquetages depuis le dernier global
+    long  seuil;
+    bool  globalDemande, fini;
+    pthread_barrier_t barriere;
+    pthread_mutex_t verrouDepart; // porte de départ des threads
+    pthread_cond_t  depart;
+    bool  partez;
+} PushRelabelParallele;
+
+typedef struct {
+    PushRelabelParallele *pp;
+    int id;
+    int64_t poussees, reetiquetages, arcs;   // statistiques propres au thread
+} TravailleurPR;
+
+static int chargerInt(const int *p) { return __atomic_load_n(p, __ATOMIC_RELAXED); }
+static Capacite chargerCapa(const Capacite *p) { return __atomic_load_n(p, __ATOMIC_RELAXED); }
+static void ajouterCapa(Capacite *p, Capacite k) { __atomic_fetch_add(p, k, __ATOMIC_SEQ_CST); }
+
+static void ppEnfiler(PushRelabelParallele *pp, int v, int quelle) {
+    int i = __atomic_fetch_add(&pp->taille[quelle], 1, __ATOMIC_RELAXED);
+    pp->file[quelle][i] = v;
+}
+
+/***********************************************************************************************************/
+/* Action ppDecharger :                                                                                    */
+/*   - opération de Hong et He : u pousse vers son voisin résiduel le plus bas s'il est plus haut que lui, */
+/*     sinon u prend la hauteur de ce voisin + 1 ; on recommence tant que u a de l'excédent                */
+/*   - à la fin, u libère son drapeau puis se ré-enfile si de l'excédent est arrivé entre-temps            */
+/***********************************************************************************************************/
+static void ppDecharger(TravailleurPR *t, int u) {
+    PushRelabelParallele *pp = t->pp;
+    PushRelabel *pr = pp->pr;
+    Graphe *rg = pr->rg;
+    int n = pr->n, suivante = pp->courante ^ 1;
+    Capacite ex;
+    while ((ex = chargerCapa(&pr->excedent[u])) > 0) {
+        int du = pr->d[u];
+        if (du >= n) break;
+        int meilleur = -1, hmin = INT_MAX;
+        t->arcs += rg->debut[u + 1] - rg->debut[u];
+        for (int e = rg->debut[u]; e < rg->debut[u + 1]; e++) {
+            if (chargerCapa(&rg->capa[e]) > 0) {
+                int h = chargerInt(&pr->d[rg->SommetDest[e]]);
+                if (h < hmin) { hmin = h; meilleur = e; }
+            }
+        }
+        if (meilleur >= 0 && du > hmin) {
+            int v = rg->SommetDest[meilleur];
+            Capacite c = chargerCapa(&rg->capa[meilleur]);
+            Capacite k = (ex < c) ? ex : c;
+            t->poussees++;
+            ajouterCapa(&rg->capa[meilleur], -k);
+            ajouterCapa(&rg->capa[rg->inverse[meilleur]], k);
+            ajouterCapa(&pr->excedent[u], -k);
+            ajouterCapa(&pr->excedent[v], k);
+            if (v != pr->cible && v != pr->exclu &&
+                __atomic_exchange_n(&pp->enFile[v], 1, __ATOMIC_SEQ_CST) == 0) {
+                ppEnfiler(pp, v, suivante);
+            }
+        } else {
+            int h = (meilleur < 0 || hmin >= n) ? n : hmin + 1;
+            __atomic_store_n(&pr->d[u], h, __ATOMIC_RELAXED);
+            t->reetiquetages++;
+            __atomic_fetch_add(&pp->relabels, 1, __ATOMIC_RELAXED);
+        }
+    }
+    __atomic_store_n(&pp->enFile[u], 0, __ATOMIC_SEQ_CST);
+    if (chargerCapa(&pr->excedent[u]) > 0 && pr->d[u] < n &&
+        __atomic_exchange_n(&pp->enFile[u], 1, __ATOMIC_SEQ_CST) == 0) {
+        ppEnfiler(pp, u, suivante);
+    }
+}
+
+/***********************************************************************************************************/
+/* Action ppGlobalRelabel :                                                                                */
+/*   - exécutée par tous les threads entre deux tours : BFS inverse par niveaux depuis le puits, chaque    */
+/*     thread traite une part de la frontière et réclame les sommets par compare-and-swap sur d[v]         */
+/*   - reconstruit ensuite la file courante avec les sommets actifs d'étiquette < n                        */
+/***********************************************************************************************************/
+static void ppGlobalRelabel(PushRelabelParallele *pp, TravailleurPR *t) {
+    PushRelabel *pr = pp->pr;
+    Graphe *rg = pr->rg;
+    int n = pr->n, T = pp->nbThreads, id = t->id;
+
+    for (int v = id; v < n; v += T) pr->d[v] = n;
+    pthread_barrier_wait(&pp->barriere);
+    if (id == 0) {
+        pr->d[pr->cible] = 0;
+        pp->frontiere[0][0] = pr->cible;
+        pp->tailleFrontiere[0] = 1;
+        pp->tailleFrontiere[1] = 0;
+        pp->taille[pp->courante] = 0;
+        pp->tete = 0;
+        pp->relabels = 0;
+    }
+    pthread_barrier_wait(&pp->barriere);
+
+    for (int niveau = 0, cur = 0; pp->tailleFrontiere[cur] > 0; niveau++, cur ^= 1) {
+        int taille = pp->tailleFrontiere[cur];
+        for (int i = id; i < taille; i += T) {
+            int w = pp->frontiere[cur][i];
+            t->arcs += rg->debut[w + 1] - rg->debut[w];
+            for (int e = rg->debut[w]; e < rg->debut[w + 1]; e++) {
+                int v = rg->SommetDest[e], attendu = n;
+                if (v != pr->exclu && rg->capa[rg->inverse[e]] > 0 && chargerInt(&pr->d[v]) == n &&
+                    __atomic_compare_exchange_n(&pr->d[v], &attendu, niveau + 1, false,
+                                                __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                    int j = __atomic_fetch_add(&pp->tailleFrontiere[cur ^ 1], 1, __ATOMIC_RELAXED);
+                    pp->frontiere[cur ^ 1][j] = v;
+                }
+            }
+        }
+        pthread_barrier_wait(&pp->barriere);
+        if (id == 0) pp->tailleFrontiere[cur] = 0;
+        pthread_barrier_wait(&pp->barriere);
+    }
+
+    for (int v = id; v < n; v += T) {
+        bool actif = pr->excedent[v] > 0 && pr->d[v] < n && v != pr->cible && v != pr->exclu;
+        pp->enFile[v] = actif;
+        if (actif) ppEnfiler(pp, v, pp->courante);
+    }
+    pthread_barrier_wait(&pp->barriere);
+}
+
+static void *ppTravailleur(void *arg) {
+    TravailleurPR *t = arg;
+    PushRelabelParallele *pp = t->pp;
+    pthread_mutex_lock(&pp->verrouDepart);
+    while (!pp->partez) pthread_cond_wait(&pp->depart, &pp->verrouDepart);
+    pthread_mutex_unlock(&pp->verrouDepart);
+    for (;;) {
+        if (pp->globalDemande) {
+            double debut = maintenant();
+            ppGlobalRelabel(pp, t);
+            if (t->id == 0) {
+                pp->pr->nbGlobal++;
+                pp->pr->tempsGlobal += maintenant() - debut;
+            }
+        }
+
+        int cur = pp->courante, i;
+        while ((i = __atomic_fetch_add(&pp->tete, 1, __ATOMIC_RELAXED)) < pp->taille[cur]) {
+            ppDecharger(t, pp->file[cur][i]);
+        }
+        pthread_barrier_wait(&pp->barriere);
+        if (t->id == 0) {
+            pp->taille[cur] = 0;
+            pp->tete = 0;
+            pp->courante = cur ^ 1;
+            pp->globalDemande = pp->relabels > pp->seuil;
+            pp->fini = pp->taille[cur ^ 1] == 0;
+        }
+        pthread_barrier_wait(&pp->barriere);
+        if (pp->fini) break;
+    }
+    return NULL;
+}
+
+/***********************************************************************************************************/
+/* Action pushRelabelParallele :                                                                           */
+/*   - passe 1 du push-relabel répartie sur les threads du contexte (sans verrou), passe 2 séquentielle    */
+/*   - les threads attendent à la porte de départ que tous soient créés ; si une création échoue, le       */
+/*     calcul se poursuit avec les threads déjà lancés                                                     */
+/*   - paramètres : Contexte* ctx, Graphe* rg (graphe résiduel, modifié en place), Capacite* flot          */
+/*   - retourne : DINIC_OK ou DINIC_ERREUR_MEMOIRE                                                         */
+/***********************************************************************************************************/
+DinicStatut pushRelabelParallele(Contexte *ctx, Graphe *rg, Capacite *flot) {
+    double debut = maintenant();
+    int nbThreads = nombreThreads(ctx);
+    if (nbThreads > PPR_MAX_THREADS) nbThreads = PPR_MAX_THREADS;
+    PushRelabel pr;
+    DinicStatut statut = prInit(ctx, &pr, rg);
+    if (statut != DINIC_OK) return statut;
+    pr.cible = rg->puits;
+    pr.exclu = rg->source;
+
+    size_t n = (size_t)pr.n;
+    PushRelabelParallele pp = { .pr = &pr, .globalDemande = true, .seuil = pr.n / 2 + 1 };
+    pp.enFile       = reserverTampon(ctx, T_EN_FILE, n * sizeof *pp.enFile);
+    pp.file[0]      = reserverTampon(ctx, T_FILE_TOUR0, n * sizeof *pp.file[0]);
+    pp.file[1]      = reserverTampon(ctx, T_FILE_TOUR1, n * sizeof *pp.file[1]);
+    pp.frontiere[0] = reserverTampon(ctx, T_FRONTIERE0, n * sizeof *pp.frontiere[0]);
+    pp.frontiere[1] = reserverTampon(ctx, T_FRONTIERE1, n * sizeof *pp.frontiere[1]);
+    if (!pp.enFile || !pp.file[0] || !pp.file[1] || !pp.frontiere[0] || !pp.frontiere[1]) {
+        return DINIC_ERREUR_MEMOIRE;
+    }
+    pthread_mutex_init(&pp.verrouDepart, NULL);
+    pthread_cond_init(&pp.depart, NULL);
+
+    pthread_t threads[PPR_MAX_THREADS];
+    TravailleurPR travailleurs[PPR_MAX_THREADS];
+    int lances = 1;
+    travailleurs[0] = (TravailleurPR){ .pp = &pp, .id = 0 };
+    for (int t = 1; t < nbThreads; t++, lances++) {
+        travailleurs[t] = (TravailleurPR){ .pp = &pp, .id = t };
+        if (pthread_create(&threads[t], NULL, ppTravailleur, &travailleurs[t]) != 0) break;
+    }
+    pp.nbThreads = lances;
+    pthread_barrier_init(&pp.barriere, NULL, lances);
+    pthread_mutex_lock(&pp.verrouDepart);
+    pp.partez = true;
+    pthread_cond_broadcast(&pp.depart);
+    pthread_mutex_unlock(&pp.verrouDepart);
+
+    ppTravailleur(&travailleurs[0]);
+    for (int t = 1; t < lances; t++) pthread_join(threads[t], NULL);
+    pthread_barrier_destroy(&pp.barriere);
+    pthread_cond_destroy(&pp.depart);
+    pthread_mutex_destroy(&pp.verrouDepart);
+    for (int t = 0; t < lances; t++) {
+        pr.poussees += travailleurs[t].poussees;
+        pr.reetiquetages += travailleurs[t].reetiquetages;
+        pr.arcs += travailleurs[t].arcs;
+    }
+
+    *flot = pr.excedent[rg->puits];
+    prPasse(&pr, rg->source, rg->puits);
+    prBilan(ctx, &pr, maintenant() - debut);
+    return DINIC_OK;
+}
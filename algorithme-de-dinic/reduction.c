@@ -0,0 +1,416 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "dinic_interne.h"
+
+// -----------------------------------------------------------------------------
+// Réduction du réseau avant résolution
+//
+// Trois réductions qui conservent le flot maximal :
+// - élagage : un arc u -> v ne sert que si u est accessible depuis la source et
+//   v mène au puits ; les boucles, les arcs de capacité nulle, les arcs entrant
+//   dans la source ou sortant du puits ne portent que des circuits et sont
+//   retirés ;
+// - arcs parallèles u -> v fusionnés (capacités additionnées) ;
+// - chaînes : un sommet w d'un seul arc entrant u -> w et d'un seul arc sortant
+//   w -> v est court-circuité par u -> v de capacité min.
+// Un arc créé par contraction est aussitôt fusionné avec l'arc u -> v existant
+// (table de hachage des arcs vivants), ce qui peut rendre u ou v contractable.
+//
+// Chaque arc du réseau réduit est un nœud d'un arbre de composition dont les
+// feuilles sont les arcs du réseau initial (PARALLELE : deux arcs côte à côte,
+// SERIE : deux arcs bout à bout). Les flots sont redescendus de la racine vers
+// les feuilles : une SERIE transmet son flot aux deux arcs, un PARALLELE remplit
+// le premier puis le second. Un nœud est toujours créé après ses enfants.
+// -----------------------------------------------------------------------------
+enum { NOEUD_ARC, NOEUD_PARALLELE, NOEUD_SERIE };
+
+// - nbArcs    : arcs du réseau initial (nœuds 0..nbArcs-1)
+// - u, v      : extrémités de chaque nœud ; capa : capacité
+// - gauche, droite : enfants des nœuds composés
+// - arcNoeud  : nœud de chaque arc du réseau réduit
+// - flotNoeud : zone de travail de restaurerFlots
+
+struct reduction {
+    int            nbArcs, nbNoeuds;
+    int           *u, *v;
+    Capacite      *capa;
+    unsigned char *type;
+    int           *gauche, *droite;
+    int           *arcNoeud;
+    Capacite      *flotNoeud;
+};
+
+// État de la réduction en cours
+// - vivant        : nœuds qui sont des arcs du réseau courant
+// - deg*, xor*    : degrés des sommets et XOR des nœuds incidents (le nœud lui-même
+//                   quand le degré vaut 1)
+// - debutS, ordre : nœuds vivants regroupés par origine (n + 1 et m cases)
+// - dernier       : dernier nœud vers chaque destination (n cases)
+// - pile, enPile  : sommets à contracter
+// - table         : nœuds vivants par extrémités (adressage ouvert, 'masque' + 1
+//                   cases de nœuds, CASE_VIDE / CASE_RETIREE), construite à la
+//                   première contraction
+
+typedef struct {
+    Reduction     *r;
+    int            n, source, puits;
+    unsigned char *vivant;
+    int           *degEntrant, *degSortant;
+    int           *xorEntrant, *xorSortant;
+    int           *debutS, *ordre, *dernier;
+    int           *pile;
+    char          *enPile;
+    int           *table;
+    size_t         masque;
+} Travail;
+
+#define CASE_VIDE    (-1)
+#define CASE_RETIREE (-2)
+
+static int creerNoeud(Reduction *r, int type, int a, int b, int u, int v, Capacite capa) {
+    int k = r->nbNoeuds++;
+    r->type[k] = (unsigned char)type;
+    r->gauche[k] = a;
+    r->droite[k] = b;
+    r->u[k] = u;
+    r->v[k] = v;
+    r->capa[k] = capa;
+    return k;
+}
+
+static void ajouterArc(Travail *w, int k) {
+    int u = w->r->u[k], v = w->r->v[k];
+    w->vivant[k] = 1;
+    w->degSortant[u]++;
+    w->xorSortant[u] ^= k;
+    w->degEntrant[v]++;
+    w->xorEntrant[v] ^= k;
+}
+
+static void retirerArc(Travail *w, int k) {
+    int u = w->r->u[k], v = w->r->v[k];
+    w->vivant[k] = 0;
+    w->degSortant[u]--;
+    w->xorSortant[u] ^= k;
+    w->degEntrant[v]--;
+    w->xorEntrant[v] ^= k;
+}
+
+/***********************************************************************************************************/
+/* Action fusionnerParalleles :                                                                            */
+/*   - regroupe les nœuds vivants par origine (tri par dénombrement) et remplace chaque paire d'arcs       */
+/*     u -> v par leur nœud PARALLELE ; O(n + nœuds)                                                       */
+/***********************************************************************************************************/
+static void fusionnerParalleles(Travail *w) {
+    Reduction *r = w->r;
+    int n = w->n;
+    for (int x = 0; x <= n; x++) w->debutS[x] = 0;
+    for (int k = 0; k < r->nbNoeuds; k++) {
+        if (w->vivant[k]) w->debutS[r->u[k]]++;
+    }
+    prefixSum(w->debutS, n);
+    for (int k = 0; k < r->nbNoeuds; k++) {
+        if (w->vivant[k]) w->ordre[w->debutS[r->u[k]]++] = k;
+    }
+    for (int x = n; x > 0; x--) w->debutS[x] = w->debutS[x - 1];
+    w->debutS[0] = 0;
+
+    for (int x = 0; x < n; x++) w->dernier[x] = -1;
+    for (int u = 1; u < n; u++) {
+        for (int i = w->debutS[u]; i < w->debutS[u + 1]; i++) {
+            int k = w->ordre[i], v = r->v[k], p = w->dernier[v];
+            if (p >= 0 && r->u[p] == u) {
+                retirerArc(w, p);
+                retirerArc(w, k);
+                int q = creerNoeud(r, NOEUD_PARALLELE, p, k, u, v, r->capa[p] + r->capa[k]);
+                ajouterArc(w, q);
+                w->dernier[v] = q;
+            } else {
+                w->dernier[v] = k;
+            }
+        }
+    }
+}
+
+static size_t hacher(const Travail *w, int u, int v) {
+    uint64_t h = (uint64_t)(uint32_t)u * 0x9E3779B97F4A7C15ull ^ (uint64_t)(uint32_t)v * 0xC2B2AE3D27D4EB4Full;
+    return (size_t)(h ^ (h >> 31)) & w->masque;
+}
+
+// case du nœud vivant u -> v, ou case où l'insérer (première case retirée ou vide rencontrée)
+static int* caseArc(Travail *w, int u, int v) {
+    int *libre = NULL;
+    for (size_t i = hacher(w, u, v);; i = (i + 1) & w->masque) {
+        int k = w->table[i];
+        if (k == CASE_VIDE) return libre ? libre : &w->table[i];
+        if (k == CASE_RETIREE) {
+            if (!libre) libre = &w->table[i];
+        } else if (w->r->u[k] == u && w->r->v[k] == v) {
+            return &w->table[i];
+        }
+    }
+}
+
+static void oublierArc(Travail *w, int k) {
+    *caseArc(w, w->r->u[k], w->r->v[k]) = CASE_RETIREE;
+    retirerArc(w, k);
+}
+
+static bool contractable(const Travail *w, int x) {
+    return x != w->source && x != w->puits && !w->enPile[x] && w->degEntrant[x] == 1 && w->degSortant[x] == 1;
+}
+
+/***********************************************************************************************************/
+/* Action contracterChaines :                                                                              */
+/*   - court-circuite tant que possible les sommets d'un arc entrant et d'un arc sortant ; un circuit      */
+/*     u -> w -> u est retiré (flot nul), un arc u -> v déjà présent est fusionné avec le nouveau          */
+/*   - la table des arcs vivants (au plus 2 insertions par arc vivant au départ, donc jamais pleine avec   */
+/*     4 cases par arc) n'est construite que s'il y a un sommet à contracter                               */
+/*   - retourne : DINIC_OK ou DINIC_ERREUR_MEMOIRE                                                         */
+/***********************************************************************************************************/
+static DinicStatut contracterChaines(Travail *w) {
+    Reduction *r = w->r;
+    int sommet = 0;
+    for (int x = 1; x < w->n; x++) {
+        if (contractable(w, x)) {
+            w->pile[sommet++] = x;
+            w->enPile[x] = 1;
+        }
+    }
+    if (sommet == 0) return DINIC_OK;
+    size_t vivants = 0, taille = 16;
+    for (int k = 0; k < r->nbNoeuds; k++) vivants += w->vivant[k];
+    while (taille < 4 * vivants) taille *= 2;
+    w->table = malloc(taille * sizeof *w->table);
+    if (!w->table) return DINIC_ERREUR_MEMOIRE;
+    w->masque = taille - 1;
+    for (size_t i = 0; i < taille; i++) w->table[i] = CASE_VIDE;
+    for (int k = 0; k < r->nbNoeuds; k++) {
+        if (w->vivant[k]) *caseArc(w, r->u[k], r->v[k]) = k;
+    }
+
+    while (sommet > 0) {
+        int x = w->pile[--sommet];
+        w->enPile[x] = 0;
+        if (w->degEntrant[x] != 1 || w->degSortant[x] != 1) continue;
+        int a = w->xorEntrant[x], b = w->xorSortant[x];
+        int u = r->u[a], v = r->v[b];
+        oublierArc(w, a);
+        oublierArc(w, b);
+        if (u != v) {
+            Capacite c = (r->capa[a] < r->capa[b]) ? r->capa[a] : r->capa[b];
+            int k = creerNoeud(r, NOEUD_SERIE, a, b, u, v, c);
+            int *place = caseArc(w, u, v);
+            if (*place >= 0) {
+                int p = *place;
+                retirerArc(w, p);
+                k = creerNoeud(r, NOEUD_PARALLELE, p, k, u, v, r->capa[p] + c);
+            }
+            *place = k;
+            ajouterArc(w, k);
+        }
+        if (contractable(w, u)) {
+            w->pile[sommet++] = u;
+            w->enPile[u] = 1;
+        }
+        if (contractable(w, v)) {
+            w->pile[sommet++] = v;
+            w->enPile[v] = 1;
+        }
+    }
+    return DINIC_OK;
+}
+
+/***********************************************************************************************************/
+/* Action atteindre :                                                                                      */
+/*   - marque (vu[x] = 1) les sommets accessibles depuis 'depart' dans un CSR (debut, dest) par les arcs   */
+/*     de capacité > 0 (capa NULL : tous les arcs) ; file : n cases                                        */
+/***********************************************************************************************************/
+static void atteindre(int depart, const int *debut, const int *dest, const Capacite *capa, char *vu, int *file) {
+    int head = 0, tail = 0;
+    file[tail++] = depart;
+    vu[depart] = 1;
+    while (head < tail) {
+        int x = file[head++];
+        for (int e = debut[x]; e < debut[x + 1]; e++) {
+            int y = dest[e];
+            if (!vu[y] && (!capa || capa[e] > 0)) {
+                vu[y] = 1;
+                file[tail++] = y;
+            }
+        }
+    }
+}
+
+void libererReduction(Reduction *r) {
+    if (!r) return;
+    free(r->u);
+    free(r->v);
+    free(r->capa);
+    free(r->type);
+    free(r->gauche);
+    free(r->droite);
+    free(r->arcNoeud);
+    free(r->flotNoeud);
+    free(r);
+}
+
+/***********************************************************************************************************/
+/* Action reduireGraphe :                                                                                  */
+/*   - élagage par double accessibilité (depuis la source, puis vers le puits dans le graphe transposé     */
+/*     restreint aux arcs de capacité > 0 issus de sommets accessibles), fusion des arcs parallèles,       */
+/*     contraction des chaînes, enfin renumérotation des sommets restants dans un nouveau CSR              */
+/*   - O(n + m) en moyenne                                                                                 */
+/***********************************************************************************************************/
+DinicStatut reduireGraphe(Contexte *ctx, const Graphe *g, Graphe **reduit, Reduction **res) {
+    *reduit = NULL;
+    *res = NULL;
+    ctx->erreur[0] = '\0';
+    double debut = maintenant();
+    int n = g->nbSommets, m = g->nbArcs, s = g->source, t = g->puits;
+    size_t nbMax = 2 * (size_t)m + 1;
+
+    Reduction *r = calloc(1, sizeof *r);
+    Travail w = { .r = r, .n = n, .source = s, .puits = t };
+    char *avant = calloc((size_t)n, 1), *arriere = calloc((size_t)n, 1);
+    w.enPile = calloc((size_t)n, 1);
+    w.vivant = calloc(nbMax, 1);
+    w.debutS = calloc((size_t)n + 1, sizeof(int));
+    w.ordre = malloc(((size_t)m + 1) * sizeof(int));
+    w.dernier = malloc((size_t)n * sizeof(int));
+    w.pile = malloc((size_t)n * sizeof(int));
+    w.degEntrant = calloc((size_t)n, sizeof(int));
+    w.degSortant = calloc((size_t)n, sizeof(int));
+    w.xorEntrant = calloc((size_t)n, sizeof(int));
+    w.xorSortant = calloc((size_t)n, sizeof(int));
+    if (r) {
+        r->nbArcs = m;
+        r->u = malloc(nbMax * sizeof *r->u);
+        r->v = malloc(nbMax * sizeof *r->v);
+        r->capa = malloc(nbMax * sizeof *r->capa);
+        r->type = malloc(nbMax);
+        r->gauche = malloc(nbMax * sizeof *r->gauche);
+        r->droite = malloc(nbMax * sizeof *r->droite);
+        r->flotNoeud = malloc(nbMax * sizeof *r->flotNoeud);
+    }
+    DinicStatut statut = DINIC_OK;
+    Graphe *h = NULL;
+    if (!r || !avant || !arriere || !w.enPile || !w.vivant || !w.debutS || !w.ordre || !w.dernier || !w.pile ||
+        !w.degEntrant || !w.degSortant || !w.xorEntrant || !w.xorSortant || !r->u || !r->v || !r->capa ||
+        !r->type || !r->gauche || !r->droite || !r->flotNoeud) {
+        statut = fixerErreur(ctx, DINIC_ERREUR_MEMOIRE, "réduction d'un graphe de %d arcs trop grande", m);
+        goto fin;
+    }
+
+    // élagage : accessibilité depuis la source, puis vers le puits (transposé dans debutS / ordre)
+    atteindre(s, g->debut, g->SommetDest, g->capa, avant, w.pile);
+    for (int u = 1; u < n; u++) {
+        if (!avant[u]) continue;
+        for (int e = g->debut[u]; e < g->debut[u + 1]; e++) {
+            if (g->capa[e] > 0) w.debutS[g->SommetDest[e]]++;
+        }
+    }
+    prefixSum(w.debutS, n);
+    memcpy(w.dernier, w.debutS, (size_t)n * sizeof(int));
+    for (int u = 1; u < n; u++) {
+        if (!avant[u]) continue;
+        for (int e = g->debut[u]; e < g->debut[u + 1]; e++) {
+            if (g->capa[e] > 0) w.ordre[w.dernier[g->SommetDest[e]]++] = u;
+        }
+    }
+    atteindre(t, w.debutS, w.ordre, NULL, arriere, w.pile);
+
+    r->nbNoeuds = m;
+    for (int u = 1; u < n; u++) {
+        for (int e = g->debut[u]; e < g->debut[u + 1]; e++) {
+            int v = g->SommetDest[e];
+            r->type[e] = NOEUD_ARC;
+            r->u[e] = u;
+            r->v[e] = v;
+            r->capa[e] = g->capa[e];
+            if (g->capa[e] > 0 && u != v && v != s && u != t && avant[u] && arriere[v]) ajouterArc(&w, e);
+        }
+    }
+    fusionnerParalleles(&w);
+    if (contracterChaines(&w) != DINIC_OK) {
+        statut = fixerErreur(ctx, DINIC_ERREUR_MEMOIRE, "réduction d'un graphe de %d arcs trop grande", m);
+        goto fin;
+    }
+
+    // renumérotation des sommets restants et CSR réduit (arcs dans l'ordre de création des nœuds)
+    int *numero = w.dernier;
+    int nbSommets = 1, nbArcs = 0;
+    for (int x = 1; x < n; x++) {
+        numero[x] = (x == s || x == t || w.degEntrant[x] + w.degSortant[x] > 0) ? nbSommets++ : 0;
+        nbArcs += w.degSortant[x];
+    }
+    h = allocGraph(nbSommets, nbArcs, false);
+    r->arcNoeud = malloc(((size_t)nbArcs + 1) * sizeof *r->arcNoeud);
+    if (!h || !r->arcNoeud) {
+        statut = fixerErreur(ctx, DINIC_ERREUR_MEMOIRE, "graphe réduit de %d arcs trop grand", nbArcs);
+        goto fin;
+    }
+    h->source = numero[s];
+    h->puits = numero[t];
+    for (int x = 0; x <= nbSommets; x++) h->debut[x] = 0;
+    for (int x = 1; x < n; x++) {
+        if (numero[x]) h->debut[numero[x]] = w.degSortant[x];
+    }
+    prefixSum(h->debut, nbSommets);
+    memcpy(w.debutS, h->debut, (size_t)nbSommets * sizeof(int));
+    for (int k = 0; k < r->nbNoeuds; k++) {
+        if (!w.vivant[k]) continue;
+        int e = w.debutS[numero[r->u[k]]]++;
+        h->SommetDest[e] = numero[r->v[k]];
+        h->capa[e] = r->capa[k];
+        h->flot[e] = 0;
+        r->arcNoeud[e] = k;
+    }
+    *reduit = h;
+    *res = r;
+    h = NULL;
+    r = NULL;
+
+fin:
+    freeGraph(h);
+    libererReduction(r);
+    free(avant);
+    free(arriere);
+    free(w.enPile);
+    free(w.vivant);
+    free(w.debutS);
+    free(w.ordre);
+    free(w.dernier);
+    free(w.pile);
+    free(w.degEntrant);
+    free(w.degSortant);
+    free(w.xorEntrant);
+    free(w.xorSortant);
+    free(w.table);
+    ctx->stats.tempsReduction += maintenant() - debut;
+    return statut;
+}
+
+/***********************************************************************************************************/
+/* Action restaurerFlots :                                                                                 */
+/*   - flots du réseau réduit redescendus dans l'arbre de composition, des derniers nœuds créés aux        */
+/*     premiers, jusqu'aux arcs du réseau initial ; les arcs retirés reçoivent un flot nul                 */
+/***********************************************************************************************************/
+void restaurerFlots(Reduction *r, const Graphe *reduit, Graphe *g) {
+    Capacite *f = r->flotNoeud;
+    for (int k = 0; k < r->nbNoeuds; k++) f[k] = 0;
+    for (int e = 0; e < reduit->nbArcs; e++) f[r->arcNoeud[e]] = reduit->flot[e];
+    for (int k = r->nbNoeuds - 1; k >= r->nbArcs; k--) {
+        int a = r->gauche[k], b = r->droite[k];
+        if (r->type[k] == NOEUD_SERIE) {
+            f[a] = f[k];
+            f[b] = f[k];
+        } else {
+            f[a] = (f[k] < r->capa[a]) ? f[k] : r->capa[a];
+            f[b] = f[k] - f[a];
+        }
+    }
+    for (int e = 0; e < g->nbArcs; e++) g->flot[e] = f[e];
+}
@@ -0,0 +1,39 @@
+#!/bin/sh
+# -----------------------------------------------------------------------------
+# Rapport de passage à l'échelle du push-relabel parallèle (--algo=parallel)
+#
+# UTILISATION : ./scaling.sh [-n THREADS_MAX] <fichier.dimacs>...
+#   - exécute dinic sur chaque fichier avec 1, 2, 4, ... THREADS_MAX threads
+#   - THREADS_MAX vaut par défaut le nombre de cœurs de la machine
+#   - écrit sur la sortie standard un CSV : graphe,threads,temps_s,acceleration,flot
+#     (acceleration = temps avec 1 thread / temps avec N threads)
+# -----------------------------------------------------------------------------
+set -e
+
+DINIC=$(realpath "${DINIC:-./dinic}")
+MAX=$(getconf _NPROCESSORS_ONLN)
+if [ "$1" = "-n" ]; then MAX=$2; shift 2; fi
+if [ $# -eq 0 ]; then
+    echo "Usage : $0 [-n THREADS_MAX] <fichier.dimacs>..." >&2
+    exit 1
+fi
+
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+echo "graphe,threads,temps_s,acceleration,flot"
+for f in "$@"; do
+    chemin=$(realpath "$f")
+    ref=""
+    t=1
+    while [ "$t" -le "$MAX" ]; do
+        debut=$(date +%s.%N)
+        (cd "$TMP" && "$DINIC" --algo=parallel --threads="$t" "$chemin" > /dev/null)
+        fin=$(date +%s.%N)
+        [ -z "$ref" ] && ref=$(awk "BEGIN { print $fin - $debut }")
+        flot=$(sed -n 's/^Flot maximal : //p' "$TMP/resultat.txt")
+        awk -v g="$(basename "$f")" -v t="$t" -v d="$debut" -v e="$fin" -v r="$ref" -v f="$flot" \
+            'BEGIN { printf "%s,%d,%.3f,%.2f,%s\n", g, t, e - d, r / (e - d), f }'
+        if [ "$t" -lt "$MAX" ] && [ $((t * 2)) -gt "$MAX" ]; then t=$MAX; else t=$((t * 2)); fi
+    done
+done
@@ -0,0 +1,289 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "dinic_interne.h"
+
+// -----------------------------------------------------------------------------
+// Réseaux à capacités unitaires
+//
+// Quand toutes les capacités résiduelles valent 0 ou 1, l'état d'un arc tient
+// en un bit : Dinic travaille sur un tableau de bits (2m bits au lieu de 2m
+// Capacite) et chaque chemin augmentant sature tous ses arcs, ce qui ramène
+// chaque phase à O(E) et le calcul à O(E.sqrt(V)) sur un réseau unitaire simple.
+// Si les arcs de capacité 1 forment un couplage biparti (source -> G, G -> D,
+// D -> puits, un seul arc de la source vers chaque sommet de G et de chaque
+// sommet de D vers le puits), Hopcroft-Karp calcule le couplage directement,
+// sans toucher au graphe résiduel avant la fin.
+// Dans les deux cas rg->capa est réécrit à la fin : la suite (updateNetworkFlow,
+// ecrireResultat) ne voit pas la différence.
+// -----------------------------------------------------------------------------
+#define COTE_AUCUN  0
+#define COTE_GAUCHE 1
+#define COTE_DROIT  2
+
+static inline bool bitLibre(const uint64_t *bits, int a) {
+    return (bits[a >> 6] >> (a & 63)) & 1;
+}
+
+static inline void inverserBit(uint64_t *bits, int a) {
+    bits[a >> 6] ^= (uint64_t)1 << (a & 63);
+}
+
+/***********************************************************************************************************/
+/* Action estUnitaire :                                                                                    */
+/*   - vrai si chaque paire d'arcs résiduels a une capacité totale de 0 ou 1 : une poussée ne fait alors   */
+/*     que passer le bit d'un arc à l'autre (un arc non orienté, 1 dans les deux sens, ne l'est pas)       */
+/***********************************************************************************************************/
+bool estUnitaire(const Graphe *rg) {
+    for (int a = 0; a < rg->nbArcs; a++) {
+        if ((uint64_t)rg->capa[a] > 1) return false;
+    }
+    // chaque paire n'est lue qu'une fois, depuis son arc de plus petit indice
+    for (int a = 0; a < rg->nbArcs; a++) {
+        if (rg->capa[a] == 1 && a < rg->inverse[a] && rg->capa[rg->inverse[a]] == 1) return false;
+    }
+    return true;
+}
+
+/***********************************************************************************************************/
+/* Action reconnaitreBiparti :                                                                             */
+/*   - classe les sommets en G (extrémités des arcs unitaires sortant de la source) et D (origines des     */
+/*     arcs unitaires entrant dans le puits) et vérifie que tout autre arc unitaire va de G vers D         */
+/*   - arcExterne[v] : arc source -> v (v dans G) ou v -> puits (v dans D)                                 */
+/*   - retourne : true si le réseau unitaire est un couplage biparti                                       */
+/***********************************************************************************************************/
+static bool reconnaitreBiparti(const Graphe *rg, unsigned char *cote, int *arcExterne) {
+    int n = rg->nbSommets, s = rg->source, t = rg->puits;
+    memset(cote, COTE_AUCUN, (size_t)n);
+    int nbG = 0, nbD = 0;
+    for (int b = rg->debut[s]; b < rg->debut[s + 1]; b++) {
+        int v = rg->SommetDest[b];
+        if (rg->capa[rg->inverse[b]] != 0) return false;          // arc vers la source
+        if (rg->capa[b] == 0) continue;
+        if (v == t || cote[v] != COTE_AUCUN) return false;      // arc direct ou arcs parallèles
+        cote[v] = COTE_GAUCHE;
+        arcExterne[v] = b;
+        nbG++;
+    }
+    for (int b = rg->debut[t]; b < rg->debut[t + 1]; b++) {
+        int v = rg->SommetDest[b], a = rg->inverse[b];
+        if (rg->capa[b] != 0) return false;                       // arc sortant du puits
+        if (rg->capa[a] == 0) continue;
+        if (cote[v] != COTE_AUCUN) return false;
+        cote[v] = COTE_DROIT;
+        arcExterne[v] = a;
+        nbD++;
+    }
+    if (nbG == 0 || nbD == 0) return false;
+    for (int u = 1; u < n; u++) {
+        if (u == s || u == t) continue;
+        for (int a = rg->debut[u]; a < rg->debut[u + 1]; a++) {
+            if (rg->capa[a] == 0) continue;
+            int v = rg->SommetDest[a];
+            bool versPuits = (v == t && cote[u] == COTE_DROIT);
+            if (!versPuits && !(cote[u] == COTE_GAUCHE && cote[v] == COTE_DROIT)) return false;
+        }
+    }
+    return true;
+}
+
+/***********************************************************************************************************/
+/* Action hopcroftKarp :                                                                                   */
+/*   - partenaire[u] : arc u -> v du couplage (u dans G, -1 si libre) ; partenaire[v] : sommet u (v dans D,*/
+/*     0 si libre) ; couplage glouton initial puis phases BFS (distances depuis les sommets libres de G)   */
+/*     et DFS itératifs sur les chemins alternés les plus courts, O(E.sqrt(V))                             */
+/*   - les arcs G -> D gardent leur capacité pendant le calcul ; le couplage est reporté dans rg à la fin  */
+/***********************************************************************************************************/
+static DinicStatut hopcroftKarp(Contexte *ctx, Graphe *rg, const unsigned char *cote, const int *arcExterne,
+                                Capacite *flot) {
+    size_t n = (size_t)rg->nbSommets;
+    int *partenaire = reserverTampon(ctx, T_PARTENAIRE, n * sizeof *partenaire);
+    int *dist       = reserverTampon(ctx, T_NIVEAU, n * sizeof *dist);
+    int *courant    = reserverTampon(ctx, T_COURANT, n * sizeof *courant);
+    int *pile       = reserverTampon(ctx, T_PILE, n * sizeof *pile);
+    int *pileArcs   = reserverTampon(ctx, T_PILE_ARCS, n * sizeof *pileArcs);
+    int *file       = reserverTampon(ctx, T_FILE, n * sizeof *file);
+    if (!partenaire || !dist || !courant || !pile || !pileArcs || !file) return DINIC_ERREUR_MEMOIRE;
+
+    Statistiques *st = &ctx->stats;
+    int64_t arcs = 0, taille = 0;
+    for (size_t v = 0; v < n; v++) partenaire[v] = (cote[v] == COTE_GAUCHE) ? -1 : 0;
+    for (int u = 1; u < (int)n; u++) {
+        if (cote[u] != COTE_GAUCHE) continue;
+        for (int a = rg->debut[u]; a < rg->debut[u + 1]; a++) {
+            int v = rg->SommetDest[a];
+            if (rg->capa[a] != 0 && partenaire[v] == 0) {
+                partenaire[u] = a;
+                partenaire[v] = u;
+                taille++;
+                break;
+            }
+        }
+        arcs += rg->debut[u + 1] - rg->debut[u];
+    }
+    st->nbChemins += taille;
+    st->longueurChemins += 3 * taille;
+
+    for (;;) {
+        // BFS : couches alternées depuis les sommets libres de G
+        double t0 = maintenant();
+        int head = 0, tail = 0;
+        bool libreAtteint = false;
+        for (int u = 1; u < (int)n; u++) {
+            dist[u] = -1;
+            if (cote[u] == COTE_GAUCHE && partenaire[u] < 0) {
+                dist[u] = 0;
+                file[tail++] = u;
+            }
+        }
+        while (head < tail) {
+            int u = file[head++];
+            arcs += rg->debut[u + 1] - rg->debut[u];
+            for (int a = rg->debut[u]; a < rg->debut[u + 1]; a++) {
+                if (rg->capa[a] == 0) continue;
+                int w = partenaire[rg->SommetDest[a]];
+                if (w == 0) libreAtteint = true;
+                else if (dist[w] < 0) {
+                    dist[w] = dist[u] + 1;
+                    file[tail++] = w;
+                }
+            }
+        }
+        double t1 = maintenant();
+        st->nbBfs++;
+        st->tempsBfs += t1 - t0;
+        if (!libreAtteint) break;
+
+        // DFS itératifs : pile[i] sommet de G, pileArcs[i] arc emprunté depuis pile[i]
+        memcpy(courant, rg->debut, n * sizeof *courant);
+        for (int racine = 1; racine < (int)n; racine++) {
+            if (cote[racine] != COTE_GAUCHE || partenaire[racine] >= 0) continue;
+            int top = 0;
+            pile[top++] = racine;
+            while (top > 0) {
+                int u = pile[top - 1], a = courant[u], fin = rg->debut[u + 1], w = -1;
+                for (; a < fin; a++) {
+                    if (rg->capa[a] == 0) continue;
+                    w = partenaire[rg->SommetDest[a]];
+                    if (w == 0 || dist[w] == dist[u] + 1) break;
+                }
+                arcs += a - courant[u] + (a < fin);
+                courant[u] = a + 1;
+                if (a == fin) {
+                    dist[u] = -1;                                     // impasse pour la phase
+                    top--;
+                    continue;
+                }
+                pileArcs[top - 1] = a;
+                if (w != 0) {
+                    pile[top++] = w;
+                    continue;
+                }
+                // sommet libre de D atteint : le chemin alterné est inversé
+                for (int i = 0; i < top; i++) {
+                    partenaire[pile[i]] = pileArcs[i];
+                    partenaire[rg->SommetDest[pileArcs[i]]] = pile[i];
+                }
+                st->nbChemins++;
+                st->longueurChemins += 2 * top + 1;
+                taille++;
+                break;
+            }
+        }
+        st->tempsAugmentation += maintenant() - t1;
+    }
+    st->arcsParcourus += arcs;
+
+    for (int u = 1; u < (int)n; u++) {
+        if (cote[u] != COTE_GAUCHE || partenaire[u] < 0) continue;
+        int a = partenaire[u], v = rg->SommetDest[a];
+        int chemin[3] = { arcExterne[u], a, arcExterne[v] };
+        for (int i = 0; i < 3; i++) {
+            rg->capa[chemin[i]] = 0;
+            rg->capa[rg->inverse[chemin[i]]] = 1;
+        }
+    }
+    *flot = taille;
+    return DINIC_OK;
+}
+
+/***********************************************************************************************************/
+/* Action flotUnitaire :                                                                                   */
+/*   - Hopcroft-Karp si le réseau unitaire est un couplage biparti, sinon Dinic sur les bits : chaque      */
+/*     arrivée au puits sature tout le chemin, le DFS repart donc de la source (les arcs saturés sont      */
+/*     sautés grâce à courant[])                                                                           */
+/***********************************************************************************************************/
+DinicStatut flotUnitaire(Contexte *ctx, Graphe *rg, Capacite *flot) {
+    size_t n = (size_t)rg->nbSommets, m = (size_t)rg->nbArcs;
+    unsigned char *cote = reserverTampon(ctx, T_COTE, n);
+    int *arcExterne     = reserverTampon(ctx, T_ARC_EXTERNE, n * sizeof *arcExterne);
+    if (!cote || !arcExterne) return DINIC_ERREUR_MEMOIRE;
+    if (reconnaitreBiparti(rg, cote, arcExterne)) return hopcroftKarp(ctx, rg, cote, arcExterne, flot);
+
+    size_t nbMots = (m + 63) / 64 + 1;
+    uint64_t *bits = reserverTampon(ctx, T_BITS_RESIDUEL, nbMots * sizeof *bits);
+    int *niveau    = reserverTampon(ctx, T_NIVEAU, n * sizeof *niveau);
+    int *courant   = reserverTampon(ctx, T_COURANT, n * sizeof *courant);
+    int *pile      = reserverTampon(ctx, T_PILE, n * sizeof *pile);
+    if (!bits || !niveau || !courant || !pile) return DINIC_ERREUR_MEMOIRE;
+    memset(bits, 0, nbMots * sizeof *bits);
+    for (size_t a = 0; a < m; a++) {
+        if (rg->capa[a]) bits[a >> 6] |= (uint64_t)1 << (a & 63);
+    }
+
+    Statistiques *st = &ctx->stats;
+    int s = rg->source, t = rg->puits;
+    int64_t arcs = 0, chemins = 0, longueur = 0;
+    for (;;) {
+        double t0 = maintenant();
+        bool atteint;
+        if (construireNiveauxBits(ctx, rg, bits, niveau, &atteint) != DINIC_OK) return DINIC_ERREUR_MEMOIRE;
+        double t1 = maintenant();
+        st->nbBfs++;
+        st->tempsBfs += t1 - t0;
+        if (!atteint) break;
+
+        memcpy(courant, rg->debut, n * sizeof *courant);
+        int top = 0, u = s;
+        for (;;) {
+            if (u == t) {
+                for (int i = 0; i < top; i++) {
+                    inverserBit(bits, pile[i]);
+                    inverserBit(bits, rg->inverse[pile[i]]);
+                }
+                chemins++;
+                longueur += top;
+                top = 0;
+                u = s;
+                continue;
+            }
+            int a = courant[u], fin = rg->debut[u + 1];
+            while (a < fin && !(bitLibre(bits, a) && niveau[rg->SommetDest[a]] == niveau[u] + 1)) a++;
+            arcs += a - courant[u] + (a < fin);
+            courant[u] = a;
+            if (a < fin) {
+                pile[top++] = a;
+                u = rg->SommetDest[a];
+            } else {
+                if (top == 0) break;
+                top--;
+                u = (top == 0) ? s : rg->SommetDest[pile[top - 1]];
+                courant[u]++;
+            }
+        }
+        st->tempsAugmentation += maintenant() - t1;
+    }
+    st->nbChemins += chemins;
+    st->longueurChemins += longueur;
+    st->arcsParcourus += arcs;
+
+    for (size_t a = 0; a < m; a++) rg->capa[a] = bitLibre(bits, (int)a);
+    *flot = chemins;
+    return DINIC_OK;
+}
+
+DinicStatut dinicUnitaire(Contexte *ctx, Graphe *rg, Capacite *flot) {
+    if (!estUnitaire(rg)) return fixerErreur(ctx, DINIC_ERREUR_PARAMETRE, "capacités non unitaires");
+    return flotUnitaire(ctx, rg, flot);
+}